@@ -0,0 +1,418 @@
+/*	aeslib.c  --  AES encipherment functions in C.
+
+	AES is the Rijndael block cipher, with a 16-byte block and a key
+	of 16, 24 or 32 bytes, as specified in FIPS-197.  It is offered as
+	an alternative to the BassOmatic for conventional encryption, and
+	is used only in counter (CTR) mode, so only the forward cipher is
+	needed, and a whole run of blocks can be enciphered together.
+
+	This implementation uses no lookup tables at all, and it never
+	branches on or indexes memory with secret data, so the time it
+	takes doesn't depend on the key or the text.  The state is kept
+	bitsliced:  plane i holds bit i of each of the 16 bytes of a block,
+	one block per 16-bit lane, as many blocks as fit in an aesplane.
+	The S-box is computed, rather than looked up, as the inverse in
+	GF(2^8), x^254, followed by the affine transformation.  ShiftRows
+	and MixColumns just move bits around within each lane.  On the
+	8086 there are no AES instructions to use instead.
+
+	Within a lane, byte n of a block is bit n, which is row n%4 and
+	column n/4 of the state, just as the bytes of a block are ordered
+	in FIPS-197.
+*/
+
+/* Define STATIC as blank to assist execution performance profiling. */
+#define STATIC static	/* define STATIC as static for normal use */
+
+#include "aeslib.h"	/* AES headers */
+
+#define LANEMULT ((aesplane) -1 / 0xffff)	/* 1 in every lane */
+#define LANES(m) ((aesplane) (m) * LANEMULT)	/* 16-bit m in every lane */
+
+static AESCONTEXT theaescontext;	/* used by initaesctr, aesctr, etc. */
+
+
+/*
+**	burnplanes - fill count aesplanes with zeros
+*/
+STATIC void burnplanes(register aesplane *p, register short count)
+{	while (count--)
+		*p++ = 0;
+}	/* burnplanes */
+
+
+/*
+**	pack - bitslice nblocks blocks into the 8 planes of p
+*/
+STATIC void pack(aesplane *p, register byteptr in, short nblocks)
+{	register short n, i;
+	burnplanes(p,8);
+	for (n=0; n<nblocks*AESBLOCKSIZE; n++)	/* byte n goes in bit n */
+	{	for (i=0; i<8; i++)
+			p[i] |= (aesplane) ((*in >> i) & 1) << n;
+		in++;
+	}
+}	/* pack */
+
+
+/*
+**	unpack - unbitslice the 8 planes of p into nblocks blocks
+*/
+STATIC void unpack(register byteptr out, aesplane *p, short nblocks)
+{	register short n, i;
+	register byte c;
+	for (n=0; n<nblocks*AESBLOCKSIZE; n++)
+	{	c = 0;
+		for (i=0; i<8; i++)
+			c |= (byte) ((p[i] >> n) & 1) << i;
+		*out++ = c;
+	}
+}	/* unpack */
+
+
+/*
+**	gfmul - multiply bitsliced a and b in GF(2^8), giving c
+**	Uses the AES polynomial, x^8 + x^4 + x^3 + x + 1.
+**	c may be the same as a or b.
+*/
+STATIC void gfmul(aesplane *c, aesplane *a, aesplane *b)
+{	aesplane p[15];		/* unreduced product */
+	register short i, j;
+	burnplanes(p,15);
+	for (i=0; i<8; i++)
+		for (j=0; j<8; j++)
+			p[i+j] ^= a[i] & b[j];
+	for (i=14; i>=8; i--)	/* x^8 = x^4 + x^3 + x + 1 */
+	{	p[i-4] ^= p[i];
+		p[i-5] ^= p[i];
+		p[i-7] ^= p[i];
+		p[i-8] ^= p[i];
+	}
+	for (i=0; i<8; i++)
+		c[i] = p[i];
+}	/* gfmul */
+
+
+/*
+**	gfsquare - square bitsliced a in GF(2^8), giving c
+**	Squaring just spreads the bits out, so it's cheaper than gfmul.
+**	c may be the same as a.
+*/
+STATIC void gfsquare(aesplane *c, aesplane *a)
+{	aesplane p[15];		/* unreduced square */
+	register short i;
+	for (i=0; i<8; i++)
+	{	p[2*i] = a[i];
+		if (i < 7)
+			p[2*i+1] = 0;
+	}
+	for (i=14; i>=8; i--)	/* x^8 = x^4 + x^3 + x + 1 */
+	{	p[i-4] ^= p[i];
+		p[i-5] ^= p[i];
+		p[i-7] ^= p[i];
+		p[i-8] ^= p[i];
+	}
+	for (i=0; i<8; i++)
+		c[i] = p[i];
+}	/* gfsquare */
+
+
+/*
+**	subbytes - AES S-box on every byte of bitsliced s
+**	The inverse of each byte is x^254, with 0 going to 0, computed with
+**	4 multiplies and 7 squarings, then the affine transformation.
+*/
+STATIC void subbytes(aesplane *s)
+{	aesplane x2[8], x3[8], x12[8], x14[8], t[8];
+	register short i;
+	gfsquare(x2,s);		/* x^2 */
+	gfmul(x3,x2,s);		/* x^3 */
+	gfsquare(t,x3);		/* x^6 */
+	gfsquare(x12,t);	/* x^12 */
+	gfmul(x14,x12,x2);	/* x^14 */
+	gfmul(t,x12,x3);	/* x^15 */
+	gfsquare(t,t);		/* x^30 */
+	gfsquare(t,t);		/* x^60 */
+	gfsquare(t,t);		/* x^120 */
+	gfsquare(t,t);		/* x^240 */
+	gfmul(t,t,x14);		/* x^254 */
+	/* affine transformation, with the constant 0x63 */
+	for (i=0; i<8; i++)
+		s[i] = t[i] ^ t[(i+4)&7] ^ t[(i+5)&7] ^ t[(i+6)&7] ^ t[(i+7)&7];
+	s[0] = ~s[0];
+	s[1] = ~s[1];
+	s[5] = ~s[5];
+	s[6] = ~s[6];
+	burnplanes(x2,8);	/* burn the evidence */
+	burnplanes(x3,8);
+	burnplanes(x12,8);
+	burnplanes(x14,8);
+	burnplanes(t,8);
+}	/* subbytes */
+
+
+/*
+**	shiftrows - rotate row r of the state left by r columns
+*/
+STATIC void shiftrows(register aesplane *s)
+{	register aesplane x;
+	register short i;
+	for (i=0; i<8; i++)
+	{	x = s[i];
+		s[i] = (x & LANES(0x1111))	/* row 0 stays put */
+			| ((x >> 4) & LANES(0x0222)) | ((x << 12) & LANES(0x2000))
+			| ((x >> 8) & LANES(0x0044)) | ((x << 8) & LANES(0x4400))
+			| ((x >> 12) & LANES(0x0008)) | ((x << 4) & LANES(0x8880));
+	}
+}	/* shiftrows */
+
+
+/* rotate each column of a plane up 1 or 2 rows */
+#define rotrows1(x) ((((x) >> 1) & LANES(0x7777)) | (((x) << 3) & LANES(0x8888)))
+#define rotrows2(x) ((((x) >> 2) & LANES(0x3333)) | (((x) << 2) & LANES(0xcccc)))
+
+/*
+**	mixcolumns - AES MixColumns on bitsliced s
+**	Each byte becomes 2*a0 + 3*a1 + a2 + a3, where a1, a2 and a3 are
+**	the bytes 1, 2 and 3 rows below it in its column, which is
+**	2*(a0 + a1) + a1 + (a2 + a3).
+*/
+STATIC void mixcolumns(register aesplane *s)
+{	aesplane t[8];		/* a0 + a1 */
+	aesplane u[8];		/* a1 + a2 + a3 */
+	register short i;
+	for (i=0; i<8; i++)
+	{	t[i] = rotrows1(s[i]);
+		u[i] = t[i];
+		t[i] ^= s[i];
+		u[i] ^= rotrows2(t[i]);
+	}
+	/* multiply t by 2, x^8 = x^4 + x^3 + x + 1, and add u */
+	s[0] = t[7] ^ u[0];
+	s[1] = t[0] ^ t[7] ^ u[1];
+	s[2] = t[1] ^ u[2];
+	s[3] = t[2] ^ t[7] ^ u[3];
+	s[4] = t[3] ^ t[7] ^ u[4];
+	s[5] = t[4] ^ u[5];
+	s[6] = t[5] ^ u[6];
+	s[7] = t[6] ^ u[7];
+}	/* mixcolumns */
+
+
+/*
+**	addroundkey - xor round key k into bitsliced s
+*/
+STATIC void addroundkey(register aesplane *s, register aesplane *k)
+{	register short i;
+	for (i=0; i<8; i++)
+		s[i] ^= k[i];
+}	/* addroundkey */
+
+
+/*
+**	subword - AES S-box on each of the 4 bytes of w, for aes_initkey
+*/
+STATIC void subword(byteptr w)
+{	aesplane s[8];
+	byte block[AESBLOCKSIZE];
+	short i;
+	for (i=0; i<AESBLOCKSIZE; i++)
+		block[i] = w[i&3];
+	pack(s,block,1);
+	subbytes(s);
+	unpack(block,s,1);
+	for (i=0; i<4; i++)
+		w[i] = block[i];
+	for (i=0; i<AESBLOCKSIZE; i++)	/* burn the evidence */
+		block[i] = 0;
+	burnplanes(s,8);
+}	/* subword */
+
+
+/*
+**	aes_initkey - initialize AES key schedule tables
+**
+**	Expands the key as in FIPS-197, then bitslices each round key and
+**	copies it into every lane.
+*/
+int aes_initkey(AESCONTEXT *ac, byteptr key, short keylen)
+/*	ac is the key context to set up.
+	key is pointer to key buffer.
+	keylen is length of key buffer, must be 16, 24 or 32 bytes.
+*/
+{	byte w[(AESMAXROUNDS+1)*AESBLOCKSIZE+AESBLOCKSIZE]; /* expanded key */
+	byte temp[5];	/* one word, and room to rotate it */
+	byte rcon;	/* round constant */
+	short i, j, nk;
+	unsigned b;	/* byte index, for burning */
+	aesplane *k;
+
+	aes_close(ac);	/* burn any previous key schedule */
+	if (keylen != 16 && keylen != 24 && keylen != 32)
+		return(-1);	/* error return, not an AES key length */
+
+	nk = keylen/4;	/* key length in 32-bit words */
+	ac->nrounds = nk + 6;
+	for (i=0; i<keylen; i++)
+		w[i] = key[i];
+	rcon = 1;
+	for (i=nk; i < 4*(ac->nrounds+1); i++)	/* for each word */
+	{	for (j=0; j<4; j++)
+			temp[j] = w[4*(i-1)+j];
+		if (i % nk == 0)
+		{	temp[4] = temp[0];	/* rotate word left a byte */
+			subword(temp+1);
+			temp[1] ^= rcon;
+			rcon = (rcon << 1) ^ ((rcon & 0x80) ? 0x1b : 0);
+			for (j=0; j<4; j++)
+				temp[j] = temp[j+1];
+		}
+		else if (nk > 6 && i % nk == 4)
+			subword(temp);
+		for (j=0; j<4; j++)
+			w[4*i+j] = w[4*(i-nk)+j] ^ temp[j];
+	}
+
+	for (i=0; i<=ac->nrounds; i++)	/* bitslice the round keys */
+	{	k = ac->roundkey[i];
+		pack(k,w+i*AESBLOCKSIZE,1);
+		for (j=0; j<8; j++)
+			k[j] *= LANEMULT;	/* copy lane 0 to every lane */
+	}
+	for (b=0; b<sizeof(w); b++)	/* burn the evidence */
+		w[b] = 0;
+	for (b=0; b<sizeof(temp); b++)
+		temp[b] = 0;
+	ac->initialized = TRUE;
+	return(0);	/* normal return */
+}	/* aes_initkey */
+
+
+/*
+**	aes_encipher - encipher up to AESLANES blocks with AES, all at once
+**
+**	Assumes aes_initkey has already been called for ac.
+*/
+void aes_encipher(AESCONTEXT *ac, byteptr in, byteptr out, short nblocks)
+/*	ac is the key context.
+	in and out are input, output blocks, nblocks*16 bytes each.
+	in and out may be the same.
+	nblocks must be from 1 to AESLANES.
+*/
+{	aesplane s[8];
+	short r;
+	pack(s,in,nblocks);
+	addroundkey(s,ac->roundkey[0]);
+	for (r=1; r<ac->nrounds; r++)
+	{	subbytes(s);
+		shiftrows(s);
+		mixcolumns(s);
+		addroundkey(s,ac->roundkey[r]);
+	}
+	subbytes(s);	/* last round has no mixcolumns */
+	shiftrows(s);
+	addroundkey(s,ac->roundkey[ac->nrounds]);
+	unpack(out,s,nblocks);
+	burnplanes(s,8);	/* burn the evidence */
+}	/* aes_encipher */
+
+
+/*
+**	aes_initctr - Initializes the AES key schedule via key, and
+**	initializes the counter (CTR) mode counter block.
+*/
+int aes_initctr(AESCONTEXT *ac, byteptr ctr0, byteptr key, short keylen)
+/* 	ac is the key context to set up.
+	ctr0 is the first counter block, 16 bytes, usually a nonce followed
+	by zeros.  It will be counted up by aes_ctr.
+	key is pointer to key buffer, 16, 24 or 32 bytes long.
+	keylen is length of key buffer.
+*/
+{	int status;
+	status = aes_initkey(ac,key,keylen);
+	ac->ctr = ctr0;	/* counter block belongs to the caller */
+	ac->ctrleft = 0;	/* no keystream yet */
+	return (status);
+}	/* aes_initctr */
+
+
+/*
+**	aes_ctr - encipher with AES enciphering algorithm, using counter
+**		(CTR) mode.
+**
+**	Each block of keystream is the counter block enciphered, and the
+**	counter block is counted up by one after each block, treated as
+**	MSB-first.  The keystream doesn't depend on the text, so AESLANES
+**	counter blocks are enciphered together, and enciphering and
+**	deciphering are the same.
+*/
+void aes_ctr(AESCONTEXT *ac, byteptr buf, int count)
+/*	ac is the key context.
+	buf is input, output buffer, may be more than 1 block.
+	count is byte count of buffer.
+*/
+{	int chunksize;	/* smaller of count, keystream on hand */
+	byteptr ks;
+	unsigned n;	/* lane */
+	short i;
+
+	while (count > 0)
+	{	if (ac->ctrleft == 0)	/* keystream is spent */
+		{	for (n=0; n<AESLANES; n++)
+			{	ks = ac->keystream + n*AESBLOCKSIZE;
+				for (i=0; i<AESBLOCKSIZE; i++)
+					ks[i] = ac->ctr[i];
+				i = AESBLOCKSIZE;	/* count up the counter block */
+				while (i-- && ++ac->ctr[i] == 0)
+					;	/* propagate carry */
+			}
+			aes_encipher(ac,ac->keystream,ac->keystream,AESLANES);
+			ac->ctrleft = sizeof(ac->keystream);
+		}
+		chunksize = min(count,(int) ac->ctrleft);
+		ks = ac->keystream + sizeof(ac->keystream) - ac->ctrleft;
+		ac->ctrleft -= chunksize;
+		count -= chunksize;
+		while (chunksize--)
+			*buf++ ^= *ks++;
+	}
+}	/* aes_ctr */
+
+
+/*
+**	aes_close - end an AES key context, burning its key schedule.
+*/
+void aes_close(AESCONTEXT *ac)
+{	register byteptr p;
+	register unsigned i;
+	p = (byteptr) ac;
+	for (i=0; i<sizeof(AESCONTEXT); i++)	/* burn the evidence */
+		*p++ = 0;
+}	/* aes_close */
+
+
+/*
+**	initaesctr - Initializes the single AES key context used by aesctr,
+**	and initializes the counter (CTR) mode counter block.
+*/
+int initaesctr(byteptr ctr0, byteptr key, short keylen)
+{	return(aes_initctr(&theaescontext,ctr0,key,keylen));
+}	/* initaesctr */
+
+
+/*
+**	aesctr - encipher or decipher with AES in counter (CTR) mode,
+**	using the key context set up by initaesctr.
+*/
+void aesctr(byteptr buf, int count)
+{	aes_ctr(&theaescontext,buf,count);
+}	/* aesctr */
+
+
+/*
+**	closeaes - end the key context used by initaesctr and aesctr.
+*/
+void closeaes(void)
+{	aes_close(&theaescontext);
+}	/* closeaes */
+
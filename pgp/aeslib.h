@@ -0,0 +1,108 @@
+/*	aeslib.h - include file for AES encipherment functions.
+
+	AES (Rijndael) with 128, 192 or 256 bit keys, in counter mode, as
+	an alternative to the BassOmatic for conventional encryption.
+*/
+
+/* Elaborate protection mechanisms to assure no redefinitions of types...*/
+#ifndef BOOLSTUFF
+#define BOOLSTUFF
+#ifndef TRUE
+#define FALSE 0
+#define TRUE (!FALSE)
+#endif	/* if TRUE not already defined */
+typedef unsigned char boolean;	/* values are TRUE or FALSE */
+#endif	/* if BOOLSTUFF not already defined */
+#ifndef BYTESTUFF
+#define BYTESTUFF
+typedef unsigned char byte;	/* values are 0-255 */
+typedef byte *byteptr;	/* pointer to byte */
+typedef char *string;	/* pointer to ASCII character string */
+#endif	/* if BYTESTUFF not already defined */
+#ifndef WORDSTUFF
+#define WORDSTUFF
+typedef unsigned short word16;	/* values are 0-65536 */
+typedef unsigned long word32;	/* values are 0-4294967296 */
+#endif	/* if WORDSTUFF not already defined */
+#ifndef min	/* if min macro not already defined */
+#define min(a,b) ( (a)<(b) ? (a) : (b) )
+#define max(a,b) ( (a)>(b) ? (a) : (b) )
+#endif	/* if min macro not already defined */
+
+
+#define AESBLOCKSIZE 16	/* bytes per AES block */
+#define AESMAXROUNDS 14	/* rounds for a 256-bit key */
+
+/*	The AES state is kept bitsliced:  bit i of each of the 16 bytes of
+	a block goes in one 16-bit lane of plane i.  An aesplane holds as
+	many lanes as it has room for, so that many blocks are enciphered
+	at once.
+*/
+typedef unsigned long aesplane;	/* 2 lanes with MSC, 4 on LP64 hosts */
+#define AESLANES (sizeof(aesplane)*8/16)	/* blocks enciphered at once */
+
+/*	An AESCONTEXT holds everything AES needs for one key, so any number
+	of them may be in use at once.  An AESCONTEXT must be all zeros
+	before its first use, as static storage is, or else be passed to
+	aes_close first.
+*/
+typedef struct {
+	aesplane roundkey[AESMAXROUNDS+1][8];	/* bitsliced, in every lane */
+	byte	keystream[AESBLOCKSIZE*AESLANES];	/* for aes_ctr */
+	boolean	initialized;	/* determines whether key context is defined */
+	short	nrounds;	/* 10, 12 or 14, set by key length */
+	byteptr	ctr;	/* CTR counter block, supplied by caller */
+	word16	ctrleft;	/* # of keystream bytes left */
+	} AESCONTEXT;
+
+
+/*
+**	aes_initkey - Sets up key schedule for AES in context ac.
+**	keylen must be 16, 24 or 32 bytes.
+*/
+int aes_initkey(AESCONTEXT *ac, byteptr key, short keylen);
+
+/*
+**	aes_encipher - Encipher nblocks blocks with AES ECB mode, using ac.
+**	nblocks must be from 1 to AESLANES.
+*/
+void aes_encipher(AESCONTEXT *ac, byteptr in, byteptr out, short nblocks);
+
+/*
+**	aes_initctr - Initializes the AES key schedule of ac via key, and
+**	initializes the counter (CTR) mode counter block.
+*/
+int aes_initctr(AESCONTEXT *ac, byteptr ctr0, byteptr key, short keylen);
+
+/*
+**	aes_ctr - encipher or decipher with AES in counter (CTR) mode,
+**		using ac.  Assumes aes_initctr has already been called for ac.
+*/
+void aes_ctr(AESCONTEXT *ac, byteptr buf, int count);
+
+/*
+**	aes_close - end an AES key context, burning its key schedule.
+*/
+void aes_close(AESCONTEXT *ac);
+
+
+/*	The following functions all use a single key context of their own,
+	for callers that need only one key at a time.
+*/
+
+/*
+**	initaesctr - Initializes the AES key schedule and the counter (CTR)
+**	mode counter block.  ctr0 is 16 bytes.
+*/
+int initaesctr(byteptr ctr0, byteptr key, short keylen);
+
+/*
+**	aesctr - encipher or decipher with AES in counter (CTR) mode.
+*/
+void aesctr(byteptr buf, int count);
+
+/*
+**	closeaes - end the AES key context, burning its key schedule.
+*/
+void closeaes(void);
+
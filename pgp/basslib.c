@@ -1,990 +1,1450 @@
-/*	basslib.c  --  BassOmatic encipherment functions in C.
-	Version 1.0  25 Jun 89 - Last revised 22 May 91
-
-	(c) Copyright 1988 by Philip Zimmermann.  All rights reserved.  
-	This software may not be copied without the written permission of 
-	Philip Zimmermann.  The author assumes no liability for damages
-	resulting from the use of this software, even if the damage results
-	from defects in this software.  No warranty is expressed or implied.
-
-	Boulder Software Engineering
-	3021 Eleventh Street
-	Boulder, CO 80304  USA
-	Tel. (303) 444-4541
-	FAX (303) 444-4541 ext. 10
-
-	BassOmatic is a conventional block cipher with a 256-byte
-	block size for the plaintext and the ciphertext.  It also
-	uses a key size of up to 256 bytes.  It runs fairly quickly
-	on a computer, faster than most simple DES implementations.
-	Like the DES, it can be used in cipher feedback and cipher block 
-	chaining modes.  It is based in part on Charles W. Merritt's 
-	algorithms which have been used in secure military communications.
-	Merritt's original designs were refined by Zhahai Stewart and
-	Philip Zimmermann to improve security and to improve performance
-	in a portable C implementation.  BassOmatic has not yet (in 1989) 
-	been through a formal security review and has had only limited peer 
-	review.  The initial version was implemented in Microsoft C for the
-	IBM PC, and it has been ported to MPW C on the Apple Macintosh 
-	and to Unix C without significant modification.
-
-	BassOmatic gets its name from an old Dan Aykroyd Saturday Night Live 
-	skit involving a blender and a whole fish.  The BassOmatic algorithm 
-	does to data what the original BassOmatic did to the fish.
-*/
-
-/* Define STATIC as blank to assist execution performance profiling. */
-#define STATIC static	/* define STATIC as static for normal use */
-
-#include <stdio.h>	/* for printf */
-
-#include "memmgr.h"	/* memory manager headers */
-#include "lfsr.h"	/* Linear Feedback Shift Register headers */
-#include "basslib.h"	/* BassOmatic headers */
-
-/* on many CPUs, using 16 bits for bytecounter is actually faster: */
-#define bytecounter word16 /* byte, or word16 for speed */
-
-#ifdef DEBUG
-#define DEBUGprintf1(x) fprintf(stderr,x)
-#define DEBUGprintf2(x,y) fprintf(stderr,x,y)
-#else
-#define DEBUGprintf1(x)	/* null macro */
-#define DEBUGprintf2(x,y)	/* null macro */
-#endif
-
-
-#define NCONTEXTS 3		/* number of key contexts allowed at once */
-	/* NUMBLOX is number of memory blocks in partition */
-#define NUMBLOX (NCONTEXTS*(NTABLES+3)+8)
-/* declare memory partition buffer space */
-static byte part[partsize(256,NUMBLOX)]; /* memory partition */
-/* We could just call calloc() for this space, instead of declaring it here. */
-
-/* The following variables comprise the keyed context information for the
-** BassOmatic machine.  If the BassOmatic is rekeyed, these variables
-** will be affected.  If more than one BassOmatic key context is needed
-** concurrently, these variables must be saved and restored for each
-** context change.
-*/
-
-static boolean initialized = FALSE; /* determines whether key context is defined */
-static byteptr tlist[NTABLES] = {nil};	/* list of permutation table pointers */
-static byte bitmasks[NTABLES];	/* bitshredder bitmasks with 50% bits set */
-
-static byteptr iv = nil; /* CFB Initialization Vector used by initcfb and basscfb */
-static boolean cfbuncryp = FALSE; /* TRUE means decrypting (in CFB mode) */
-static boolean uncryp = FALSE;	/* TRUE means decrypting (in ECB mode) */
-/* The following parameters are computed from the key control byte...*/
-static char nrounds = 0;	/* specifies number of rounds thru BassOmatic */
-static boolean hardrand = FALSE; /* means regenerate tables with BassOmatic */
-static boolean shred8ways = FALSE; /* means use 8-way bit shredding */
-static boolean rerand = FALSE;	/* means replenish tables with every block */
-
-static byteptr lfsr = nil;	/* it would help to align LFSR on 256-byte boundary */
-			/* rtail is an index into LFSR buffer */
-static byte rtail = 0;	/* points to 256, which is same as 0 */
-
-/* End of BassOmatic keyed context variables */
-
-
-
-/*
-**	fillbuf(dst,count,c) - fill byte buffer dst with byte c
-**		dst is destination buffer pointer.
-**		count is nonzero byte count.
-**		c is fill byte.
-*/
-void fillbuf(register byteptr dst, register short count, register byte c)
-{	do *dst++ = c; while (--count);
-} /* fillbuf */
-
-
-/*
-**	CRC routines are purely for debugging purposes...
-*/
-#define CRCDEBUG	/* enables CRC debugging code */
-#ifdef CRCDEBUG
-/*
-**	updcrc - updates CRC 16-bit accumulator with ch,
-**	uses CCITT polynomial:  X^16 + X^12 + X^5 + 1
-*/
-static word16 updcrc(byte ch, word16 crcaccum)
-{	word16 shifter,flag,data;
-	data = ((word16) ch) & 0xff;
-	for (shifter = 0x80; shifter; shifter >>= 1)
-	{	flag = (crcaccum & 0x8000);
-		crcaccum <<= 1;
-		crcaccum |= ((shifter & data) ? 1 : 0);
-		if (flag) crcaccum ^= 0x1021;
-	}
-	return (crcaccum & 0xffff);
-}	/* updcrc() */
-
-
-/*
-**	crc() - compute crc of buffer
-**	Used for diagnostic purposes.
-*/
-word16 crc(register byteptr buf, int count)
-{	word16 crcaccum;	/* CRC accumulator */
-	crcaccum = 0;		/* clear crc accumulator */
-	do	crcaccum = updcrc(*buf++,crcaccum);
-	while (--count);	/* loop 256 times */
-	crcaccum = updcrc(0,crcaccum);	/* finish up crc */
-	crcaccum = updcrc(0,crcaccum);	/* have to do it twice */
-	return(crcaccum);	/* return 16-bit CRC */
-} /* crc */
-
-
-#define dumpcrc(msg,buf) printf("%s CRC=%04x ",msg,crc(buf,256))
-
-/*
-**	dumpblock - dump 256-byte buffer in hex
-*/
-static void dumpblock(byteptr buf)
-{	bytecounter i;
-	i = 256;
-	printf(" Memory block at %04X: ",buf);
-	do
-	{	if ((i & 15)==0)
-			putchar('\n');
-		printf("%02X ",*buf++);
-	} while (--i);	/* loop 256 times */
-	dumpcrc("",buf-256);
-	putchar('\n');
-} /* dumpblock */
-
-#endif	/* end of CRC debugging routines */
-
-
-/*
-**	randbuf and randbuf_counter are used by initbassrand, initbrand, 
-**	bassrand, and closebrand.  They are not directly used by the BassOmatic
-**	routines except by initkey(), and thus are not considered part of a 
-**	lasting key context.  
-*/
-static byteptr randbuf = nil; /* buffer for BassOmatic random # generator */
-static byte randbuf_counter = 0;	/* # of random bytes left in randbuf */
-
-/*
-**	initbrand - initialize bassrand, BassOmatic random number generator
-**		For internal use by initkey() only.
-**		seed is pointer to random number seed buffer.
-**		seedlen is length of seed buffer, must be <= 256.
-*/
-static void initbrand(byteptr seed, short seedlen)
-{	short i;
-	if (randbuf==nil)
-		randbuf = (byteptr) gblock(part);	/* allocate block */
-
-	if (seedlen > 256) seedlen=256;
-	for (i=0; i<seedlen; i++) /* copy original seed material to randbuf */
-		randbuf[i] = seed[i];
-
-	/* fill rest of randbuf with randomly modified key material */
-	for (; i<256; i++)	/* pick up where we left off */
-		randbuf[i] = getlfsr(lfsr,rtail); /* macro gets LFSR byte */
-
-	randbuf_counter = 0;		/* # of random bytes left in randbuf */
-} /* initbrand */
-
-
-/*
-**	initbassrand - initialize bassrand, BassOmatic random number generator
-**		This can be used for generating cryptographically strong random 
-**		numbers by any external application code outside the BassOmatic.
-**		key is pointer to BassOmatic key buffer.
-**		keylen is length of key buffer, must be < 256.
-**		seed is pointer to random number seed buffer.
-**		seedlen is length of seed buffer, must be <= 256.
-**
-**		NOTE:  Because this routine calls initkey(), this generator 
-**		must be closed by calling closebass(), NOT closebrand().
-*/
-void initbassrand(byteptr key, short keylen, byteptr seed, short seedlen)
-{	short i;
-	if (randbuf==nil)	/* prevents multiple initialization */
-	{	initkey(key, keylen, FALSE);	/* initialize BassOmatic */
-		randbuf = (byteptr) gblock(part);	/* allocate block */
-	}
-	fillbuf(randbuf,256,0);		/* get a clean start */
-	if (seedlen > 256) seedlen=256;
-	for (i=0; i<seedlen; i++)	/* copy original seed material to randbuf */
-		randbuf[i] = seed[i];
-	randbuf_counter = 0;		/* # of random bytes left in randbuf */
-} /* initbassrand */
-
-
-/*
-**	bassrand - BassOmatic pseudo-random number generator
-**		This can be used for generating cryptographically strong random 
-**		numbers by any external application code outside the BassOmatic.
-*/
-byte bassrand(void)
-{	byteptr tmp;
-	if (randbuf_counter==0)	/* if random buffer is spent...*/
-	{	tmp = (byteptr) gblock(part);	/* allocate new block */
-		bassomatic(randbuf,tmp); /* fill new block */
-		rblock(part,randbuf);	/* release old spent block */
-		randbuf = tmp;		/* start on new block */
-	}
-	return(randbuf[--randbuf_counter]);	/* take a byte from randbuf */
-} /* bassrand */
-
-
-/*
-**	closebrand - deallocate storage used by bassrand
-**		For internal use by initkey() only.
-*/
-static void closebrand(void)
-{	if (randbuf!=nil)
-		randbuf = rblock(part,randbuf);	/* release block */
-} /* closebrand */
-
-
-/*
-**	buildtbl - build a random byte permutation vector
-**
-**	References context variables lfsr, rtail, and part.
-**
-**	A permutation vector is a table of 256 bytes containing the
-**	values 0-255 in random order.  Each of the values 0-255 appears
-**	exactly once in the table, with no duplicates and no omissions.
-**
-**	The appropriate way to build such a table for cryptographic
-**	applications is to do the following:
-**	1) Start with an empty table, meaning its length is zero.
-**	2) Use a pseudo-random number generator to generate random bytes
-**	   that are appended to the table if and only if they are not
-**	   already in the table.  If the random byte is already in the
-**	   table, it is discarded and another one is generated from the
-**	   pseudo-random number generator.  As the table gets nearly full,
-**	   more and more random bytes are discarded as duplicate entries.
-**	   This is continued until 256 bytes have been inserted in the table.
-**
-**	While this approach seems computationally wasteful, it makes it harder
-**	for a cryptanalyst to infer the properties of the pseudo-random number
-**	generator, because so many of its output bytes are discarded.
-**
-**	Permutation vectors such as these are useful for byte substitution
-**	tables and byte transposition tables.  These are also referred to
-**	herein as key schedule tables.
-*/
-STATIC void buildtbl(register byteptr table, boolean rselect)
-/*	table is pointer to table to build.
-	rselect is to select which of 2 random number generators to use.
-*/
-{	register byteptr notdup;	/* scratchpad bitmap */
-	register byte c;
-	register short tlen;	/* current accumulated table length */ 
-	register short randtics; /* counts LFSR tics */
-#define MAXTICS 16383		/* lose patience with LFSR after this long */
-	notdup = (byteptr) gblock(part); /* we could use local stack array instead. */
-	fillbuf(notdup,256,TRUE); /* initialize scratchpad bitmap */
-	tlen = 0;		/* start new table with length 0 */
-	/* To fill one table, we can expect to have to tic the LFSR
-		typically about 1000-2500 times, on the average. */
-	randtics = MAXTICS;	/* countdown maximum LFSR tics */
-	do
-	{	/* get pseudo-random byte from either LFSR or BassOmatic... */
-		c = rselect ?
-			bassrand() :		/* get a hard random byte */
-			getlfsr(lfsr,rtail);	/* macro gets LFSR byte */
-		if (notdup[c]) 	/* not in table already? */
-		{	table[tlen++] = c; /* append it */
-			notdup[c] = FALSE; /* indicate it's now in table */
-		}
-		if (--randtics == 0)  /* detects bogus random generator */
-		{	/* Must be an LFSR problem, because the bassrand
-				generator will probably always run OK, so we
-				won't even check rselect. */
-			DEBUGprintf1("\007Adjusting weak LFSR. ");
-			stomplfsr(lfsr); /* hit unruly LFSR upside the head */
-			randtics=MAXTICS;	/* reset countdown counter */
-		} /* randtics alarm */
-	} while (tlen<256); /* do until table is full */
-	if (!rselect)
-	/*	"discard" current contents of lfsr buffer. Causes
-		steplfsr256 to be called the next time getlfsr is called. */
-		rtail=0;	/* dump some LFSR output, confuse attacker */
-	rblock(part,notdup);	/* deallocate storage */
-} /* buildtbl */
-
-
-/*
-**	Some notes--
-**
-**	With some sacrifice of performance due to bit packing and unpacking, 
-**	it would be possible to modify the whole BassOmatic algorithm to use 
-**	a smaller block size.  This would require using smaller key schedule 
-**	tables with smaller entries.  For example, you could use a table of 
-**	16 4-bit entries instead of 256 8-bit entries.  The number of bits in 
-**	each table entry exponentialy determines the number of entries in the 
-**	key schedule table, and those two dimensions together determine the 
-**	size of the plaintext or ciphertext block.  The following chart 
-**	summarizes the relationship between table entry width and cipher 
-**	block size.
-**
-**	ENTRY       TABLE           BLOCK
-**	WIDTH       LENGTH          SIZE
-**	-----       ------          -----
-**	8 bits      256 entries     2048 bits, or 256 bytes
-**	7 bits      128 entries		896 bits, or 112 bytes
-**	6 bits      64 entries      384 bits, or 48 bytes
-**	5 bits      32 entries      160 bits, or 20 bytes
-**	4 bits      16 entries      64 bits, or 8 bytes
-**
-**
-**	Other questions--
-**	How many of the key bits are actually effective in producing the
-**	key schedule tables?  Are any key bits wasted?
-**
-**	There are 256! permutation tables possible.  With 8 tables made
-**	from a single key, there are (256!)**8 sets of tables possible.
-**	If there are n bytes in a key (with n<=256), there are 256**n
-**	keys possible.
-**
-**	In theory, more than one of these keys can produce the same table 
-**	or set of tables, since a different selection of random output 
-**	bytes from the pseudorandom number generator may be discarded to 
-**	produce the same table.
-*/
-
-
-/*
-**	invert - invert a random permutation table
-**	Called from bldtbls.
-*/
-STATIC void invert(register byteptr intable, register byteptr outtable)
-{	register byte i;
-	i = 0;		/* byte loop index i = 0,255,254,...2,1 */
-	do	outtable[intable[i]] = i; /* invert table */
-	while (--i);	/* loop 256 times */
-}	/* invert */
-
-
-/*
-**	transpose - transpose input via table to output
-**	Called from bldtbls.
-*/
-STATIC void transpose(register byteptr in, register byteptr out, register byteptr table)
-/*	in and out are the input, output blocks, 256 bytes each.
-	table contains random permutation of 256 bytes.
-*/
-{	register byte i;
-	i = 256;	/* byte loop counter */
-	do	*out++ = in[*table++];	/* table transpose */
-	while (--i);	/* loop 256 times */
-}	/* transpose */
-
-
-/*
-**	halfmask(c) - returns TRUE iff 50% of the bits in c are set.
-**	Called only from getmask.
-*/
-STATIC boolean halfmask(byte c)
-{	byte bitmask,nbits;
-	nbits=0; bitmask=0x80;
-	do 
-	{	if (c & bitmask) 
-			nbits++; /* count the # of 1 bits */
-		bitmask >>= 1;
-	} while (bitmask);
-	return(nbits==4);	/* are 4 out of 8 bits set? */
-} /* halfmask */
-
-
-/*
-**	getmask - search table for a suitable random mask byte.
-**	Finds a random mask byte with 50% of its bits set.
-**	Called from bldtbls.
-*/
-STATIC byte getmask(register byteptr table)
-/* 	table contains random permutation of 256 bytes. */
-{	byte i;
-	i = 0;		/* byte loop index i = 0,255,254,...2,1 */
-	do
-	{	if (halfmask(table[i]))
-			return(table[i]); /* returns 1st 50% bitmask found */
-	} while (--i);	/* loop 256 times */
-	return (0x0f);		/* never gets here */
-}	/* getmask */
-
-
-#define ptrswap(p1,p2) { register byteptr p3; p3=p1; p1=p2; p2=p3; }
-
-
-/*
-**	bldtbls - generate all the permutation tables for the BassOmatic
-**
-**	References context variables tlist, shred8ways, bitmasks, and part.
-*/
-STATIC void bldtbls(boolean hardrand, boolean decryp)
-/*	hardrand specifies which random number generator to use.
-	decryp determines whether to invert the tables.
-*/
-{	byteptr tmp;	/* scratchpad table pointers */
-	byteptr mixer;	/* table transposer */
-	byte i;
-	tmp = (byteptr) gblock(part);	/* allocate new block */
-
-	mixer = (byteptr) gblock(part);	/* allocate transposer table */
-	buildtbl(mixer,hardrand);
-
-	for (i=0; i<NTABLES; i++)		/* for each key schedule table */
-	{	/* build a random byte permutation vector... */
-		buildtbl(tmp,hardrand);
-		if (!shred8ways) /* need bitmasks for 2-way bitshredding */
-			bitmasks[i] = getmask(tmp);
-		/* currently, tmp is the table we just built */
-		transpose(tmp,tlist[i],mixer); /* mix up the table */
-		/* now tlist[i] is the table we just built */
-	}		/* for each table */
-
-	rblock(part,mixer);	/* deallocate transposer table */
-
-	/* For decryption, it's not safe to invert any tables until they've
-	   all been built, in case hardrand is set.  Use separate loop... */
-	if (decryp) /* decryption uses inverted tables */
-		for (i=0; i<NTABLES; i++) 	/* for each table */
-		{	invert(tlist[i],tmp);
-			ptrswap(tlist[i],tmp); /* swap/replace block ptrs */
-		}		/* for each table */
-	rblock(part,tmp);	/* deallocate block */
-	DEBUGprintf1("*");
-} /* bldtbls */
-
-
-/*
-**	bass_save - saves BassOmatic key context in context structure
-*/
-void bass_save(KEYCONTEXT *context)
-{	int i;
-	context->initialized = initialized;
-	for (i=0; i<NTABLES; i++)
-		context->tlist[i] = tlist[i];
-	for (i=0; i<NTABLES; i++)
-		context->bitmasks[i] = bitmasks[i];
-	context->iv = iv; /* note that iv was passed to initcfb by caller */
-	context->cfbuncryp = cfbuncryp;
-	context->uncryp = uncryp;
-	context->nrounds = nrounds;
-	context->hardrand = hardrand;
-	context->shred8ways = shred8ways;
-	context->rerand = rerand;
-	context->lfsr = lfsr;
-	context->rtail = rtail;
-} /* bass_save */
-
-
-/*
-**	bass_restore - restore BassOmatic key context from context structure
-*/
-void bass_restore(KEYCONTEXT *context)
-{	int i;
-	initialized = context->initialized;
-	for (i=0; i<NTABLES; i++)
-		tlist[i] = context->tlist[i];
-	for (i=0; i<NTABLES; i++)
-		bitmasks[i] = context->bitmasks[i];
-	iv = context->iv; /* note that iv was passed to initcfb by caller */
-	cfbuncryp = context->cfbuncryp;
-	uncryp = context->uncryp;
-	nrounds = context->nrounds;
-	hardrand = context->hardrand;
-	shred8ways = context->shred8ways;
-	rerand = context->rerand;
-	lfsr = context->lfsr;
-	rtail = context->rtail;
-} /* bass_restore */
-
-
-/*
-**	closebass - end the current BassOmatic key context, freeing its buffers
-*/
-void closebass(void)
-{	int i;
-	if (initialized)
-	{
-		/* Close BassOmatic random number generator, in case it's open: */
-		closebrand();
-
-		for (i=0; i<NTABLES; i++)
-			if (tlist[i]!=nil)
-				tlist[i] = rblock(part,tlist[i]);
-		/* Note that iv is not allocated from memory manager,
-			and thus should not be deallocated */
-		if (lfsr!=nil)
-			lfsr = rblock(part,lfsr);
-		initialized = FALSE;
-	}
-} /* closebass */
-
-
-static char *copyright_notice(void)
-/* force linker to include copyright notice in the executable object image. */
-{ return ("(c)1988 Philip Zimmermann"); } /* copyright_notice */
-
-
-/*
-**	initkey - Initializes the BassOmatic key schedule tables via key.
-**
-**	References context variables from key context structure, all of them.
-**
-**	Uses several bits from the first byte of the key to select
-**	how exhaustivly to run the BassOmatic.  The key control bits
-**	specify what tradeoff to make between speed and security.
-**	These bits in the first byte of the key have these meanings:
-**	bits 0-2: Number of rounds thru BassOmatic (0-7 means 1-8
-**		times through).  The greater the number, the slower
-**		it runs.
-**	bit 3:  Set to 1 if we should use slower 8-way bit shredding,
-**		Set to 0 if we should use faster 50% bitmask shredding.
-**	bit 4:	Set to 1 means use BassOmatic to build its own tables.
-**	bit 5:  Set to 1 iff we should rebuild tables with every block.
-**		This implicitly disables bit 4, above.
-**	bits 6-7:  Reserved.
-**
-**	Key control bit 4 enables a two-tiered key schedule table
-**	generation.  The first set of tables are generated in the usual
-**	way with a linear feedback shift register (LFSR).  Then, a new
-**	set of tables is regenerated with a far better pseudo-random
-**	number generator--namely, the BassOmatic running off the first
-**	set of tables.  The BassOmatic pseudo-random number generator
-**	feeds its output back into itself to generate a stream of
-**	random blocks.  It is seeded with the same raw key that
-**	seeded the LFSR.  When the new set of tables are built, they
-**	replace the first set as the working tables.
-**
-**	Key control bit 5 keeps running the pseudorandom number generator
-**	to continuously rebuild the key schedule tables for each block of text.
-**	It automatically turns off key control bit 4.  Continuously replenishing
-**	the tables greatly slows down everything, but it improves security
-**	significantly.  This mode unfortunately also makes using the BassOmatic
-**	in the DES-like cipher block chaining (CBC) and cipher feedback (CFB)
-**	modes non-self-synchronizing.
-*/
-int initkey(byteptr key, short keylen, boolean decryp)
-/*	key is pointer to key buffer, up to 256 bytes long.
-	keylen is length of key buffer, including key control byte.
-	decryp is TRUE if decrypting, FALSE if encrypting.
-*/
-{	byte i;
-
-	/* initialize BassOmatic data structures */
-	static boolean partition_initialized = FALSE;
-	if (!partition_initialized)
-	{	/* if already initialized, skip these steps. */
-		partition_initialized = TRUE;
-		pcreat2(part,256,NUMBLOX); /* initialize memory partition */
-#ifdef DEBUG2
-		dumpfree(part);		/* dump memory free list */
-#endif
-	}
-
-	if (key == nil) /* initkey(nil,0,0) only initializes partition */
-		return(0);
-
-	if (keylen < 2)
-	{	/* key must have control byte and nonzero body length */
-		fprintf(stderr,"\nError: BassOmatic key too short.\n\007");
-		return(-1);	/* error return */
-	}
-
-	closebass();	/* deallocate any previously allocated buffers */
-
-	initialized = TRUE;	/* set already initialized flag */
-	for (i=0; i<NTABLES; i++)	/* for each table */
-	{	/* get memory block from partition */
-		tlist[i] = (byteptr) gblock(part);
-	}		/* for each table */
-
-	nrounds = (*key & 0x07) + 1; /* specifies number of rounds */
-	shred8ways = ((*key & 0x08) != 0); /* use 8-way bit shredding? */
-	rerand = ((*key & 0x20) != 0); /* replenish tables with every block */
-	/* hardrand means use BassOmatic table generator... */
-	hardrand = ((*key & 0x10) != 0) && !rerand;
-	uncryp = FALSE;	/* initially assume encrypt, in case of hardrand */
-
-#ifdef DEBUG3
-	if (decryp)	/* use inverted tables for decryption */
-		fprintf(stderr,"Decrypt, ");
-	else		/* use non-inverted tables for encryption */
-		fprintf(stderr,"Encrypt, ");
-	fprintf(stderr,"%x rounds, ",nrounds);
-	if (hardrand)	/* BassOmatic random number generator */
-		fprintf(stderr,"hard ");
-	else		/* LFSR random number generator */
-		fprintf(stderr,"LFSR ");
-	if (rerand)	/* rebuild tables for every block */
-		fprintf(stderr,"dynamic ");
-	else		/* keep same tables throughout message */
-		fprintf(stderr,"static ");
-	fprintf(stderr,"tables, ");
-	
-	if (shred8ways)
-		fprintf(stderr,"8-way bitshred.\n");
-	else
-		fprintf(stderr,"2-way bitshred.\n");
-#endif	/* DEBUG3 */
-
-	/* init LFSR random number generator with key seed */
-	if (lfsr==nil)
-		lfsr = (byteptr) gblock(part); /* allocate LFSR buffer */
-	if (keylen > 255) keylen=255;
-	/* Assume actual key starts after 1st byte, which is control byte */
-	initlfsr(key+1,keylen-1,lfsr,&rtail);
-	/* dumpblock(lfsr); */
-
-	buildtbl(tlist[0],FALSE); /* build throwaway table to prime the LFSR */
-
-	/* generate all the permutation tables for the key schedule */
-	if (!rerand)	/* don't do it now if it's going to be redone anyway */
-		bldtbls(FALSE,decryp && !hardrand);
-
-	/* if hardrand, rebuild tables again, this time with BassOmatic */
-	if (hardrand)	/* rebuild tables with BassOmatic */
-	{	/* form progressivly better bassrand function. */
-		/* init BassOmatic pseudo-random generator */
-		initbrand(key+1,keylen-1); /* skip 1st key byte */
-		bldtbls(hardrand,decryp);/* generate all the tables again */
-		closebrand();	/* deallocate scratch buffers for bassrand */
-	} /* if (hardrand) */
-	uncryp = decryp;	/* specifies BassOmatic decrypt or encrypt */
-
-	if (!rerand)	/* if we don't need lfsr buffer anymore, then free it. */
-		lfsr=rblock(part,lfsr); /* sure hope we don't use lfsr again */
-
-	/* Do an explicit reference to the copyright notice so that the linker 
-	   will be forced to include it in the executable object image... */
-	copyright_notice();	/* has no real effect at run time */
-	return(0);	/* normal return */
-} /* initkey */
-
-
-/* Now for the primitives called directly from the BassOmatic algorithm...*/
-
-
-/*
-**	shred1bit - 8-way random bit shred
-**
-**	Tears each byte into 8 bits, and randomly distributes the bits.
-**	Uses 8 different permutation vectors from tlist.
-**	Unfortunately, it always uses the same 8 tables.
-*/
-STATIC void shred1bit(register byteptr in, register byteptr out)
-/*	in and out are input, output blocks, 256 bytes each. */
-{	register byte bitmask;	/* byte has 1 of its bits set */
-	register bytecounter i;
-	register byteptr table;	/* permutation vector */
-	byteptr insave;		/* for saving input buffer pointer */
-	byte j;
-	bitmask = 0x80;		/* initialize bitmask at highest bit */
-	fillbuf(out,256,0);	/* make sure output buffer is clean */
-	/* We could run faster by skipping the fillbuf step, and
-	   using "=" instead of "|=" the first time thru the j loop below. */
-
-	insave = in;		/* save input buffer pointer */
-	for (j=0; j<=7; j++)	/* for each of 8 bits per byte */
-	{	i = 256;	/* byte loop counter */
-		table = tlist[j]; /* select a permutation vector */
-		in = insave;	/* recover input buffer pointer */
-		do	/* permute a single bit from each byte */
-			out[*table++] |= (*in++ & bitmask);
-		while (--i);	/* loop 256 times */
-		bitmask >>= 1;	/* select next bit for isolation */
-	}
-}	/* shred1bit */
-
-
-/*
-**	shred4bit - 2-way random bit shred
-**
-**	Tears each byte in half, and randomly distributes the halves.
-*/
-STATIC void shred4bit(register byteptr in, register byteptr out, 
-	register byteptr t1, register byteptr t2, register byte bitmask)
-/*	in and out are input, output blocks, 256 bytes each.
-	t1 and t2 each contain random permutation of 256 bytes.
-	bitmask is byte which has 50% of its bits set.
-*/
-{	register bytecounter i;
-	byteptr insave;		/* for saving input buffer pointer */
-	insave = in;		/* save input buffer pointer */
-	i = 256;		/* byte loop counter */
-	do			/* isolate half the bits */
-		out[*t1++] = *in++ & bitmask;
-	while (--i);		/* loop 256 times */
-	in = insave;		/* recover input buffer pointer */
-	bitmask = ~bitmask;	/* invert bitmask for other half */
-	i = 256;		/* byte loop counter */
-	do		/* isolate other half and combine the two halfs */
-		out[*t2++] |= *in++ & bitmask;
-	while (--i);		/* loop 256 times */
-}	/* shred4bit */
-
-
-/*
-**	multilookup - change input via multiple substitution tables
-*/
-STATIC void multilookup(register byteptr in, register byteptr out, byte ti)
-/*	in and out are input, output blocks, 256 bytes each.
-	ti contains index into starting point of tlist.
-*/
-{	register byteptr table;
-	register byte i;
-	byte j;
-	j=8;
-	do
-	{	table = tlist[ti++ & 7];	/* assumes 8 tables */
-		i=32;
-		do	*out++ = table[*in++];	/* multi-table substitute */
-		while (--i);	/* loop 32 times */
-	}
-	while (--j);	/* loop 8 times */
-}	/* multilookup */
-
-
-/*
-**	xortable - change block via xor with random table
-**
-**	This function would serve as its own inverse, if the table is the 
-**	same each time.  For use with an inverted table, call ixortable.
-**	This function inverts 50% of the bits.
-*/
-STATIC void xortable(register byteptr block, register byteptr table)
-/*	block is a 256 byte block.
-	table contains random permutation of 256 bytes.
-*/
-{	register bytecounter i;
-	i = 256;	/* byte loop counter */
-	do	*block++ ^= *table++;	/* table xor */
-	while (--i);	/* loop 256 times */
-}	/* xortable */
-
-
-/*
-**	ixortable - change block via xor with inverted random table
-**
-**	This function inverts 50% of the bits.  It is the inverse function
-**	for xortable, if the table is inverted.  Used for decryption.
-*/
-STATIC void ixortable(register byteptr block, register byteptr table)
-/*	block is a 256 byte block.
-	table contains random permutation of 256 bytes.
-*/
-{	register byte i;
-	i = 0;		/* byte loop index i = 0,255,254,...2,1 */
-	do	block[table[i]] ^= i;	/* inverted table xor */
-	while (--i);	/* loop 256 times */
-}	/* ixortable */
-
-
-/*
-**	rake - rake forwards and backwards with xor and add
-**
-**	This is not a keyed operation.  It is only useful for increasing
-**	the intersymbol dependencies between the plaintext and the ciphertext,
-**	not the key and the ciphertext.  Its inverse is function unrake.
-*/
-STATIC void rake(register byteptr block)
-{	register byte i;
-	register byteptr block1;
-	block1 = block++;
-	/* now block1 = 0, block = 1, relatively speaking */
-	i = 255;	/* loop 255 times */
-	/* first do forward raking with cumulative xor */
-	do	/*  from  *1++ ^= *0++;  thru  *255++ ^= *254++; */
-		*block++ ^= *block1++;
-	while (--i);
-	/* now block1 = 255, block = 256 */
-	i = 255;	/* loop 255 times */
-	/* now do backward raking with cumulative add */
-	do	/*  from  *(--255) += *(--256);  thru  *(--1) += *(--2); */
-		*(--block1) += *(--block);
-	while (--i);
-	/* now block1 = 0, block = 1 */
-}	/* rake */
-
-
-/*
-**	unrake - unrake forwards and backwards with subtract and xor
-**
-**	This is the inverse function of rake.  Used for decryption.
-*/
-STATIC void unrake(register byteptr block)
-{	register byte i;
-	register byteptr block1;
-	block1 = block++;
-	/* now block1 = 0, block = 1, relatively speaking */
-	i = 255;	/* loop 255 times */
-	/* first do forward unraking with cumulative subtract */
-	do	/*  from  *0++ -= *1++;  thru  *254++ -= *255++; */
-		*block1++ -= *block++;
-	while (--i);
-	/* now block1 = 255, block = 256 */
-	i = 255;	/* loop 255 times */
-	/* now do backward unraking with cumulative xor */
-	do	/*  from  *(--256) ^= *(--255);  thru  *(--2) ^= *(--1); */
-		*(--block) ^= *(--block1);
-	while (--i);
-	/* now block1 = 0, block = 1 */
-}	/* unrake */
-
-
-/*
-**	copy256(dst,src) - copy 256-byte buffer src to dst
-*/
-void copy256(register byteptr dst, register byteptr src)
-{	register bytecounter size;
-	size = 256;	/* loop 256 times */
-	do *dst++ = *src++; while (--size);
-} /* copy256 */
-
-
-#define f(i,j) (((i)+(j)) & 7)	/* used for circular addressing mod 8 */
-#define tl(i,j) tlist[f(i,j)]	/* assumes 8 tables */
-
-
-/*
-**	bassomatic - encipher 1 block with BassOmatic enciphering algorithm
-**
-**	Assumes initkey has already been called.
-**	References context variables tlist, nrounds, shred8ways,
-**	bitmasks, uncryp, rerand, and part.
-*/
-void bassomatic(byteptr in, byteptr out)
-/*	in and out are input, output blocks, 256 bytes each. */
-{	char i;		/* signed char */
-	byteptr tmp;
-
-	if (rerand)	/* dynamic replenishment of tables? */
-		bldtbls(FALSE,uncryp);
-
-	tmp = (byteptr) gblock(part);	/* get memory block */
-	copy256(out,in);	/* copy in to out */
-
-	if (uncryp)
-	{ 	/* do decryption */
-		for (i=nrounds-1; i>=0; i--)	/* repeat a few rounds */
-		{	multilookup(out,tmp,f(i,2));
-			unrake(tmp);		/* not effective if last step */
-			if (shred8ways)		/* use 8-way bit shredding */
-				shred1bit(tmp,out);
-			else			/* use faster 2-way bit shredding */
-				shred4bit(tmp,out,tl(i,1),tl(i,5),
-					bitmasks[f(i,3)]);
-			ixortable(out,tl(i,0));	/* inverts 50% of bits */
-		} /* for loop */
-	}	/* if decryption */
-	else	/* do encryption */
-	{	for (i=0; i<nrounds; i++)	/* repeat a few rounds */
-		{	xortable(out,tl(i,0));	/* inverts 50% of bits */
-			if (shred8ways)		/* use 8-way bit shredding */
-				shred1bit(out,tmp);
-			else			/* use faster 2-way bit shredding */
-				shred4bit(out,tmp,tl(i,1),tl(i,5),
-					bitmasks[f(i,3)]);
-			rake(tmp);		/* not effective if last step */
-			multilookup(tmp,out,f(i,2));
-		} /* for loop */
-	}	/* else encryption */
-	rblock(part,tmp);	/* release block */
-}	/* bassomatic */
-
-
-/*
-**	xorbuf - change buffer via xor with random mask block
-**	Used for Cipher Feedback (CFB) or Cipher Block Chaining
-**	(CBC) modes of encryption.
-**	Can be applied for any block encryption algorithm,
-**	such as the DES or the BassOmatic.
-*/
-STATIC void xorbuf(register byteptr buf, register byteptr mask, register int count)
-/*	count must be > 0 */
-{	do
-		*buf++ ^= *mask++;
-	while (--count);
-}	/* xorbuf */
-
-
-/*
-**	cfbshift - shift bytes into IV for CFB input
-**	Used only for Cipher Feedback (CFB) mode of encryption.
-**	Can be applied for any block encryption algorithm,
-**	such as the DES or the BassOmatic.
-*/
-STATIC void cfbshift(register byteptr iv, register byteptr buf, 
-		register int count, int blocksize)
-/* 	iv is the initialization vector.
-	buf is the buffer pointer.
-	count is the number of bytes to shift in...must be > 0.
-	blocksize is 8 for DES, 256 for BassOmatic.
-*/
-{	int retained;
-	retained = blocksize-count;	/* number bytes in iv to retain */
-	/* left-shift retained bytes of IV over by count bytes to make room */
-	while (retained--)
-	{	*iv = *(iv+count);
-		iv++;
-	}
-	/* now copy count bytes from buf to shifted tail of IV */
-	do	*iv++ = *buf++;
-	while (--count);
-}	/* cfbshift */
-
-
-#define BLOCKSIZE 256	/* encryption block size for CFB mode. */
-
-/*
-**	initcfb - Initializes the BassOmatic key schedule tables via key,
-**	and initializes the Cipher Feedback mode IV.
-**	References context variables cfbuncryp and iv.
-*/
-int initcfb(byteptr iv0, byteptr key, short keylen, boolean decryp)
-/* 	iv0 is copied to global iv, buffer will be destroyed by basscfb.
-	key is pointer to key buffer, up to 256 bytes long.
-	keylen is length of key buffer.
-	decryp is TRUE if decrypting, FALSE if encrypting.
-*/
-{	iv = iv0;	/* iv is not allocated from memory manager */
-	cfbuncryp = decryp;
-	return (initkey(key,keylen,FALSE));
-} /* initcfb */
-
-
-/*
-**	basscfb - encipher 1 block with BassOmatic enciphering algorithm,
-**		using Cipher Feedback (CFB) mode.
-**
-**	Assumes initcfb has already been called.
-**	References context variables cfbuncryp and iv.
-*/
-void basscfb(byteptr buf, int count)
-/*	buf is input, output buffer, may be more than 1 block.
-	count is byte count of buffer.  May be > BLOCKSIZE.
-*/
-{	int chunksize;	/* smaller of count, BLOCKSIZE */
-	byte temp[BLOCKSIZE];
-
-	while ((chunksize = min(count,BLOCKSIZE)) > 0)
-	{	bassomatic(iv,temp); /* encrypt iv. */
-
-		if (cfbuncryp)	/* buf is ciphertext */
-			/* shift in ciphertext to IV... */
-			cfbshift(iv,buf,chunksize,BLOCKSIZE);
-
-		/* convert buf via xor */
-		xorbuf(buf,temp,chunksize); /* buf now has enciphered output */
-
-		if (!cfbuncryp)	/* buf was plaintext, is now ciphertext */
-			/* shift in ciphertext to IV... */
-			cfbshift(iv,buf,chunksize,BLOCKSIZE);
-
-		count -= chunksize;
-		buf += chunksize;
-	}
-} /* basscfb */
-
-
\ No newline at end of file
+/*	basslib.c  --  BassOmatic encipherment functions in C.
+	Version 1.0  25 Jun 89 - Last revised 22 May 91
+
+	(c) Copyright 1988 by Philip Zimmermann.  All rights reserved.  
+	This software may not be copied without the written permission of 
+	Philip Zimmermann.  The author assumes no liability for damages
+	resulting from the use of this software, even if the damage results
+	from defects in this software.  No warranty is expressed or implied.
+
+	Boulder Software Engineering
+	3021 Eleventh Street
+	Boulder, CO 80304  USA
+	Tel. (303) 444-4541
+	FAX (303) 444-4541 ext. 10
+
+	BassOmatic is a conventional block cipher with a 256-byte
+	block size for the plaintext and the ciphertext.  It also
+	uses a key size of up to 256 bytes.  It runs fairly quickly
+	on a computer, faster than most simple DES implementations.
+	Like the DES, it can be used in cipher feedback and cipher block 
+	chaining modes.  It is based in part on Charles W. Merritt's 
+	algorithms which have been used in secure military communications.
+	Merritt's original designs were refined by Zhahai Stewart and
+	Philip Zimmermann to improve security and to improve performance
+	in a portable C implementation.  BassOmatic has not yet (in 1989) 
+	been through a formal security review and has had only limited peer 
+	review.  The initial version was implemented in Microsoft C for the
+	IBM PC, and it has been ported to MPW C on the Apple Macintosh 
+	and to Unix C without significant modification.
+
+	BassOmatic gets its name from an old Dan Aykroyd Saturday Night Live 
+	skit involving a blender and a whole fish.  The BassOmatic algorithm 
+	does to data what the original BassOmatic did to the fish.
+*/
+
+/* Define STATIC as blank to assist execution performance profiling. */
+#define STATIC static	/* define STATIC as static for normal use */
+
+#include <stdio.h>	/* for printf */
+#include <stdlib.h>	/* for malloc, free */
+#include <string.h>	/* for memcpy */
+
+#include "lfsr.h"	/* Linear Feedback Shift Register headers */
+#include "basslib.h"	/* BassOmatic headers */
+#include "md4.h"	/* for MD4 digests of cached keys */
+
+/* on many CPUs, using 16 bits for bytecounter is actually faster: */
+#define bytecounter word16 /* byte, or word16 for speed */
+
+/*	Several of the BassOmatic primitives xor or copy whole 256-byte 
+	blocks, which goes faster a machine word at a time than a byte at 
+	a time.  blockword is the widest integer the CPU handles in one
+	instruction.  Some CPUs can't fetch a word from an odd address, so
+	these primitives only work a word at a time on word aligned blocks.
+	Key context tables and local scratch blocks always are aligned.
+*/
+typedef unsigned int blockword;	/* 16 bits on the PC, 32 on most Unix */
+#define BLOCKWORDS (256/sizeof(blockword)) /* blockwords per block */
+#define wordaligned(p) ((((unsigned long) (p)) & (sizeof(blockword)-1)) == 0)
+
+/*	getword and putword load and store the blockword at byte address p.
+	MSC does it through a cast pointer.  Other compilers may assume that
+	a byte buffer is never read as a blockword, so they get memcpy, 
+	which they turn into the same single load or store, as in lzh.c.
+*/
+#ifdef _MSC_VER
+#define getword(p) (*(blockword *)(p))
+#define putword(p,w) (*(blockword *)(p) = (w))
+#else
+STATIC blockword getword(byteptr p)
+{	blockword w;
+	memcpy(&w,p,sizeof(blockword));
+	return(w);
+}	/* getword */
+
+STATIC void putword(byteptr p, blockword w)
+{	memcpy(p,&w,sizeof(blockword));
+}	/* putword */
+#endif
+
+#ifdef DEBUG
+#define DEBUGprintf1(x) fprintf(stderr,x)
+#define DEBUGprintf2(x,y) fprintf(stderr,x,y)
+#else
+#define DEBUGprintf1(x)	/* null macro */
+#define DEBUGprintf2(x,y)	/* null macro */
+#endif
+
+
+/* The keyed context information for the BassOmatic machine lives in a
+** KEYCONTEXT structure, which holds its own key schedule tables, LFSR and
+** random number buffer.  The functions with a bass_ prefix take a pointer
+** to the context they are to use, so any number of contexts may be live
+** at once.  The older functions such as initkey and basscfb all use the
+** single context below, for callers that only need one at a time.
+*/
+static KEYCONTEXT thecontext;	/* context used by initkey, basscfb, etc. */
+
+/* End of BassOmatic keyed context variables */
+
+
+
+/*
+**	fillbuf(dst,count,c) - fill byte buffer dst with byte c
+**		dst is destination buffer pointer.
+**		count is nonzero byte count.
+**		c is fill byte.
+*/
+void fillbuf(register byteptr dst, register short count, register byte c)
+{	do *dst++ = c; while (--count);
+} /* fillbuf */
+
+
+/*
+**	copy256(dst,src) - copy 256-byte buffer src to dst
+*/
+void copy256(register byteptr dst, register byteptr src)
+{	register bytecounter size;
+	if (wordaligned(dst) && wordaligned(src))
+	{	size = BLOCKWORDS;	/* copy a word at a time */
+		do
+		{	putword(dst,getword(src));
+			dst += sizeof(blockword);
+			src += sizeof(blockword);
+		} while (--size);
+		return;
+	}
+	size = 256;	/* loop 256 times */
+	do *dst++ = *src++; while (--size);
+} /* copy256 */
+
+
+/*
+**	CRC routines are purely for debugging purposes...
+*/
+#define CRCDEBUG	/* enables CRC debugging code */
+#ifdef CRCDEBUG
+/*
+**	updcrc - updates CRC 16-bit accumulator with ch,
+**	uses CCITT polynomial:  X^16 + X^12 + X^5 + 1
+*/
+static word16 updcrc(byte ch, word16 crcaccum)
+{	word16 shifter,flag,data;
+	data = ((word16) ch) & 0xff;
+	for (shifter = 0x80; shifter; shifter >>= 1)
+	{	flag = (crcaccum & 0x8000);
+		crcaccum <<= 1;
+		crcaccum |= ((shifter & data) ? 1 : 0);
+		if (flag) crcaccum ^= 0x1021;
+	}
+	return (crcaccum & 0xffff);
+}	/* updcrc() */
+
+
+/*
+**	crc() - compute crc of buffer
+**	Used for diagnostic purposes.
+*/
+word16 crc(register byteptr buf, int count)
+{	word16 crcaccum;	/* CRC accumulator */
+	crcaccum = 0;		/* clear crc accumulator */
+	do	crcaccum = updcrc(*buf++,crcaccum);
+	while (--count);	/* loop 256 times */
+	crcaccum = updcrc(0,crcaccum);	/* finish up crc */
+	crcaccum = updcrc(0,crcaccum);	/* have to do it twice */
+	return(crcaccum);	/* return 16-bit CRC */
+} /* crc */
+
+
+#define dumpcrc(msg,buf) printf("%s CRC=%04x ",msg,crc(buf,256))
+
+/*
+**	dumpblock - dump 256-byte buffer in hex
+*/
+static void dumpblock(byteptr buf)
+{	bytecounter i;
+	i = 256;
+	printf(" Memory block at %04X: ",buf);
+	do
+	{	if ((i & 15)==0)
+			putchar('\n');
+		printf("%02X ",*buf++);
+	} while (--i);	/* loop 256 times */
+	dumpcrc("",buf-256);
+	putchar('\n');
+} /* dumpblock */
+
+#endif	/* end of CRC debugging routines */
+
+
+/*
+**	randbuf and randbuf_counter in the key context are used by 
+**	bass_initrand, initbrand, bass_rand, and closebrand.  They are not 
+**	directly used by the BassOmatic routines except by bass_initkey(), 
+**	and thus are not considered part of a lasting key context.  
+*/
+
+/*
+**	initbrand - initialize bassrand, BassOmatic random number generator
+**		For internal use by bass_initkey() only.
+**		seed is pointer to random number seed buffer.
+**		seedlen is length of seed buffer, must be <= 256.
+*/
+static void initbrand(KEYCONTEXT *kc, byteptr seed, short seedlen)
+{	short i;
+	kc->randopen = TRUE;
+
+	if (seedlen > 256) seedlen=256;
+	for (i=0; i<seedlen; i++) /* copy original seed material to randbuf */
+		kc->randbuf[i] = seed[i];
+
+	/* fill rest of randbuf with randomly modified key material */
+	for (; i<256; i++)	/* pick up where we left off */
+		kc->randbuf[i] = getlfsr(kc->lfsr,kc->rtail); /* macro gets LFSR byte */
+
+	kc->randbuf_counter = 0;	/* # of random bytes left in randbuf */
+} /* initbrand */
+
+
+/*
+**	bass_initrand - initialize BassOmatic random number generator
+**		This can be used for generating cryptographically strong random 
+**		numbers by any external application code outside the BassOmatic.
+**		kc is the key context to use.
+**		key is pointer to BassOmatic key buffer.
+**		keylen is length of key buffer, must be < 256.
+**		seed is pointer to random number seed buffer.
+**		seedlen is length of seed buffer, must be <= 256.
+**
+**		NOTE:  Because this routine calls bass_initkey(), this generator 
+**		must be closed by calling bass_close(), NOT closebrand().
+*/
+void bass_initrand(KEYCONTEXT *kc, byteptr key, short keylen, 
+	byteptr seed, short seedlen)
+{	short i;
+	if (!kc->randopen)	/* prevents multiple initialization */
+	{	bass_initkey(kc, key, keylen, FALSE);	/* initialize BassOmatic */
+		kc->randopen = TRUE;
+	}
+	fillbuf(kc->randbuf,256,0);	/* get a clean start */
+	if (seedlen > 256) seedlen=256;
+	for (i=0; i<seedlen; i++)	/* copy original seed material to randbuf */
+		kc->randbuf[i] = seed[i];
+	kc->randbuf_counter = 0;	/* # of random bytes left in randbuf */
+} /* bass_initrand */
+
+
+/*
+**	bass_rand - BassOmatic pseudo-random number generator
+**		This can be used for generating cryptographically strong random 
+**		numbers by any external application code outside the BassOmatic.
+*/
+byte bass_rand(KEYCONTEXT *kc)
+{	if (kc->randbuf_counter==0)	/* if random buffer is spent...*/
+		/* bass_block may encipher a block in place */
+		bass_block(kc,kc->randbuf,kc->randbuf); /* refill block */
+	return(kc->randbuf[--kc->randbuf_counter]); /* take a byte from randbuf */
+} /* bass_rand */
+
+
+/*
+**	bass_randfill - fill a buffer from the BassOmatic pseudo-random 
+**		number generator.  Gives the same bytes, in the same order, 
+**		as calling bass_rand count times.
+*/
+void bass_randfill(KEYCONTEXT *kc, register byteptr buf, register int count)
+{	register short left;	/* # of random bytes left in randbuf */
+	left = kc->randbuf_counter;
+	while (count--)
+	{	if (left == 0)	/* if random buffer is spent...*/
+		{	bass_block(kc,kc->randbuf,kc->randbuf); /* refill block */
+			left = 256;
+		}
+		*buf++ = kc->randbuf[--left]; /* take a byte from randbuf */
+	}
+	kc->randbuf_counter = left;	/* never 256, a byte was taken */
+} /* bass_randfill */
+
+
+/*
+**	closebrand - wipe storage used by bass_rand
+**		For internal use by bass_initkey() only.
+*/
+static void closebrand(KEYCONTEXT *kc)
+{	if (kc->randopen)
+	{	fillbuf(kc->randbuf,256,0);	/* burn the evidence */
+		kc->randopen = FALSE;
+	}
+} /* closebrand */
+
+
+/*
+**	buildtbl - build a random byte permutation vector
+**
+**	References context variables lfsr and rtail.
+**
+**	A permutation vector is a table of 256 bytes containing the
+**	values 0-255 in random order.  Each of the values 0-255 appears
+**	exactly once in the table, with no duplicates and no omissions.
+**
+**	The appropriate way to build such a table for cryptographic
+**	applications is to do the following:
+**	1) Start with an empty table, meaning its length is zero.
+**	2) Use a pseudo-random number generator to generate random bytes
+**	   that are appended to the table if and only if they are not
+**	   already in the table.  If the random byte is already in the
+**	   table, it is discarded and another one is generated from the
+**	   pseudo-random number generator.  As the table gets nearly full,
+**	   more and more random bytes are discarded as duplicate entries.
+**	   This is continued until 256 bytes have been inserted in the table.
+**
+**	While this approach seems computationally wasteful, it makes it harder
+**	for a cryptanalyst to infer the properties of the pseudo-random number
+**	generator, because so many of its output bytes are discarded.
+**
+**	Permutation vectors such as these are useful for byte substitution
+**	tables and byte transposition tables.  These are also referred to
+**	herein as key schedule tables.
+*/
+STATIC void buildtbl(KEYCONTEXT *kc, register byteptr table, boolean rselect)
+/*	kc is the key context.
+	table is pointer to table to build.
+	rselect is to select which of 2 random number generators to use.
+*/
+{	byte notdup[256];	/* scratchpad bitmap */
+	register byte c;
+	register short tlen;	/* current accumulated table length */ 
+	register short randtics; /* counts LFSR tics */
+	register byteptr lfsr;	/* LFSR buffer */
+	register short avail;	/* LFSR bytes left in buffer */
+#define MAXTICS 16383		/* lose patience with LFSR after this long */
+	fillbuf(notdup,256,TRUE); /* initialize scratchpad bitmap */
+	tlen = 0;		/* start new table with length 0 */
+	/* To fill one table, we can expect to have to tic the LFSR
+		typically about 1000-2500 times, on the average. */
+	randtics = MAXTICS;	/* countdown maximum LFSR tics */
+	if (rselect)
+	{	do
+		{	c = bass_rand(kc);	/* get a hard random byte */
+			table[tlen] = c;	/* overwritten later if duplicate */
+			tlen += notdup[c];	/* append it if not in table already */
+			notdup[c] = FALSE; /* indicate it's now in table */
+			if (--randtics == 0)
+			{	/* The bassrand generator will probably always
+					run OK, but stay as patient as with the LFSR. */
+				DEBUGprintf1("\007Adjusting weak LFSR. ");
+				stomplfsr(kc->lfsr);
+				randtics=MAXTICS;	/* reset countdown counter */
+			}
+		} while (tlen<256); /* do until table is full */
+		return;
+	}
+
+	/*	Take LFSR bytes straight from the buffer, just as getlfsr
+		would, rather than through the macro.  This is most of the
+		work of rebuilding the tables for every block. */
+	lfsr = kc->lfsr;
+	avail = kc->rtail;	/* 0 means buffer is spent */
+	do
+	{	if (avail == 0)	/* replenish lfsr buffer */
+		{	steplfsr256(lfsr);
+			avail = 256;
+		}
+		/*	Most bytes are duplicates by the time the table is half 
+			full, so rather than test each one, always store it and 
+			only count it if it wasn't in the table already. */
+		c = lfsr[--avail];
+		table[tlen] = c;	/* overwritten later if duplicate */
+		tlen += notdup[c];	/* append it if not in table already */
+		notdup[c] = FALSE; /* indicate it's now in table */
+		if (--randtics == 0)  /* detects bogus random generator */
+		{	DEBUGprintf1("\007Adjusting weak LFSR. ");
+			stomplfsr(lfsr); /* hit unruly LFSR upside the head */
+			randtics=MAXTICS;	/* reset countdown counter */
+		} /* randtics alarm */
+	} while (tlen<256); /* do until table is full */
+	/*	"discard" current contents of lfsr buffer. Causes
+		steplfsr256 to be called the next time getlfsr is called. */
+	kc->rtail=0;	/* dump some LFSR output, confuse attacker */
+} /* buildtbl */
+
+
+/*
+**	Some notes--
+**
+**	With some sacrifice of performance due to bit packing and unpacking, 
+**	it would be possible to modify the whole BassOmatic algorithm to use 
+**	a smaller block size.  This would require using smaller key schedule 
+**	tables with smaller entries.  For example, you could use a table of 
+**	16 4-bit entries instead of 256 8-bit entries.  The number of bits in 
+**	each table entry exponentialy determines the number of entries in the 
+**	key schedule table, and those two dimensions together determine the 
+**	size of the plaintext or ciphertext block.  The following chart 
+**	summarizes the relationship between table entry width and cipher 
+**	block size.
+**
+**	ENTRY       TABLE           BLOCK
+**	WIDTH       LENGTH          SIZE
+**	-----       ------          -----
+**	8 bits      256 entries     2048 bits, or 256 bytes
+**	7 bits      128 entries		896 bits, or 112 bytes
+**	6 bits      64 entries      384 bits, or 48 bytes
+**	5 bits      32 entries      160 bits, or 20 bytes
+**	4 bits      16 entries      64 bits, or 8 bytes
+**
+**
+**	Other questions--
+**	How many of the key bits are actually effective in producing the
+**	key schedule tables?  Are any key bits wasted?
+**
+**	There are 256! permutation tables possible.  With 8 tables made
+**	from a single key, there are (256!)**8 sets of tables possible.
+**	If there are n bytes in a key (with n<=256), there are 256**n
+**	keys possible.
+**
+**	In theory, more than one of these keys can produce the same table 
+**	or set of tables, since a different selection of random output 
+**	bytes from the pseudorandom number generator may be discarded to 
+**	produce the same table.
+*/
+
+
+/*
+**	invert - invert a random permutation table
+**	Called from bldtbls.
+*/
+STATIC void invert(register byteptr intable, register byteptr outtable)
+{	register byte i;
+	i = 0;		/* byte loop index i = 0,255,254,...2,1 */
+	do	outtable[intable[i]] = i; /* invert table */
+	while (--i);	/* loop 256 times */
+}	/* invert */
+
+
+/*
+**	transpose - transpose input via table to output
+**	Called from bldtbls.
+*/
+STATIC void transpose(register byteptr in, register byteptr out, register byteptr table)
+/*	in and out are the input, output blocks, 256 bytes each.
+	table contains random permutation of 256 bytes.
+*/
+{	register byte i;
+	i = 256;	/* byte loop counter */
+	do	*out++ = in[*table++];	/* table transpose */
+	while (--i);	/* loop 256 times */
+}	/* transpose */
+
+
+/*
+**	transinvert - transpose input via table, and invert the result
+**	Same as transpose followed by invert, in one pass.
+**	Called from bldtbls.
+*/
+STATIC void transinvert(register byteptr in, register byteptr out, register byteptr table)
+/*	in is the table to transpose, out is the inverted result.
+	table contains random permutation of 256 bytes.
+*/
+{	register byte i;
+	i = 0;		/* byte loop index i = 0,255,254,...2,1 */
+	do	out[in[table[i]]] = i;	/* transpose and invert */
+	while (--i);	/* loop 256 times */
+}	/* transinvert */
+
+
+/*
+**	halfmask(c) - returns TRUE iff 50% of the bits in c are set.
+**	Called only from getmask.
+*/
+STATIC boolean halfmask(byte c)
+{	byte bitmask,nbits;
+	nbits=0; bitmask=0x80;
+	do 
+	{	if (c & bitmask) 
+			nbits++; /* count the # of 1 bits */
+		bitmask >>= 1;
+	} while (bitmask);
+	return(nbits==4);	/* are 4 out of 8 bits set? */
+} /* halfmask */
+
+
+/*
+**	getmask - search table for a suitable random mask byte.
+**	Finds a random mask byte with 50% of its bits set.
+**	Called from bldtbls.
+*/
+STATIC byte getmask(register byteptr table)
+/* 	table contains random permutation of 256 bytes. */
+{	byte i;
+	i = 0;		/* byte loop index i = 0,255,254,...2,1 */
+	do
+	{	if (halfmask(table[i]))
+			return(table[i]); /* returns 1st 50% bitmask found */
+	} while (--i);	/* loop 256 times */
+	return (0x0f);		/* never gets here */
+}	/* getmask */
+
+
+/*
+**	shredindex - set column i of shredidx to the inverse of tlist[i],
+**	for shred1bit.  Must be called whenever tlist[i] changes, since
+**	hardrand keys encipher with tables that are half rebuilt.
+**	Called from bldtbls.
+*/
+STATIC void shredindex(KEYCONTEXT *kc, byte i)
+{	register byte k;
+	register byteptr table;
+	table = kc->tlist[i];
+	k = 0;		/* byte loop index k = 0,255,254,...2,1 */
+	do	kc->shredidx[table[k]][i] = k; /* invert table into column */
+	while (--k);	/* loop 256 times */
+}	/* shredindex */
+
+
+/*
+**	bldtbls - generate all the permutation tables for the BassOmatic
+**
+**	References context variables tlist, shredidx, shred8ways, and 
+**	bitmasks.
+*/
+STATIC void bldtbls(KEYCONTEXT *kc, boolean hardrand, boolean decryp)
+/*	kc is the key context.
+	hardrand specifies which random number generator to use.
+	decryp determines whether to invert the tables.
+*/
+{	byte tmp[256];		/* scratchpad table */
+	byte mixer[256];	/* table transposer */
+	byte i;
+
+	buildtbl(kc,mixer,hardrand);
+
+	for (i=0; i<NTABLES; i++)		/* for each key schedule table */
+	{	/* build a random byte permutation vector... */
+		buildtbl(kc,tmp,hardrand);
+		if (!kc->shred8ways) /* need bitmasks for 2-way bitshredding */
+			kc->bitmasks[i] = getmask(tmp);
+		/* currently, tmp is the table we just built */
+		if (decryp && !hardrand) /* decryption uses inverted tables */
+			transinvert(tmp,kc->tlist[i],mixer); /* mix up and invert */
+		else
+			transpose(tmp,kc->tlist[i],mixer); /* mix up the table */
+		/* now tlist[i] is the table we just built */
+		if (kc->shred8ways)
+			shredindex(kc,i);
+	}		/* for each table */
+
+	/* For decryption, it's not safe to invert any tables until they've
+	   all been built, in case hardrand is set.  Use separate loop... */
+	if (decryp && hardrand) /* decryption uses inverted tables */
+		for (i=0; i<NTABLES; i++) 	/* for each table */
+		{	invert(kc->tlist[i],tmp);
+			copy256(kc->tlist[i],tmp); /* replace with inverted table */
+			if (kc->shred8ways)
+				shredindex(kc,i);
+		}		/* for each table */
+	fillbuf(tmp,256,0);	/* burn the evidence */
+	fillbuf(mixer,256,0);
+	DEBUGprintf1("*");
+} /* bldtbls */
+
+
+/*
+**	bass_save - saves BassOmatic key context in context structure
+**	Copies the context used by initkey, basscfb, etc.
+*/
+void bass_save(KEYCONTEXT *context)
+{	*context = thecontext; /* note that iv was passed to initcfb by caller */
+} /* bass_save */
+
+
+/*
+**	bass_restore - restore BassOmatic key context from context structure
+**	Replaces the context used by initkey, basscfb, etc.
+*/
+void bass_restore(KEYCONTEXT *context)
+{	thecontext = *context; /* note that iv was passed to initcfb by caller */
+} /* bass_restore */
+
+
+/*
+**	bass_close - end a BassOmatic key context, burning its tables
+*/
+void bass_close(KEYCONTEXT *kc)
+{	/* This also closes the BassOmatic random number generator, 
+		in case it's open.  Note that iv is not part of the context,
+		and belongs to the caller. */
+	fillbuf((byteptr) kc,sizeof(KEYCONTEXT),0);
+	kc->initialized = FALSE;
+} /* bass_close */
+
+
+/*
+**	closebass - end the current BassOmatic key context, freeing its buffers
+*/
+void closebass(void)
+{	bass_close(&thecontext);
+} /* closebass */
+
+
+/*
+**	Setting up a key schedule is slow, and the same key is often set up
+**	more than once in a run, as when the same pass phrase reads and then
+**	rewrites a file.  So bass_initkey remembers the last few key 
+**	schedules it built, along with the MD4 message digests of the keys 
+**	they came from, and copies one of those instead when it can.  The 
+**	keys themselves are not kept.  Entries are burned when they are
+**	replaced, and by bass_flushcache, which should be called before the 
+**	program exits.  MS-DOS never swaps memory to disk, so the entries
+**	can't leak out that way while they are in the cache.  The cache is
+**	allocated on first use, from the far heap under MSC so that it 
+**	stays out of the 64K data segment, and nothing is cached if there 
+**	isn't room for it.
+*/
+/* #define NOKEYCACHE */	/* define to never cache key schedules */
+#define KEYCACHESIZE 2	/* number of key schedules remembered */
+
+#ifndef NOKEYCACHE
+#ifdef _MSC_VER	/* small model, keep the cache out of DGROUP */
+#include <malloc.h>
+#define FAR _far
+#define FarAlloc(n,s) ((void FAR *) halloc( (long) (n), (s) ))
+#define FarFree(p) hfree( (void _huge *) (p) )
+#else
+#define FAR
+#define FarAlloc(n,s) malloc( (size_t) (n) * (s) )
+#define FarFree(p) free( p )
+#endif
+
+typedef struct {
+	KEYCONTEXT context;	/* key context just after bass_initkey */
+	word32	lastuse;	/* when entry was last used, 0 if empty */
+	byte	keyhash[16];	/* MD4 message digest of key */
+	short	keylen;		/* length of key, including control byte */
+	boolean	decryp;		/* decryp flag given to bass_initkey */
+	} KEYCACHE;
+
+static KEYCACHE FAR *keycache = NULL;	/* KEYCACHESIZE entries */
+static word32 keycache_clock = 0;	/* counts key cache uses */
+
+
+/*
+**	hashkey - compute the 16-byte MD4 message digest of key.
+*/
+static void hashkey(byteptr key, short keylen, byte hash[16])
+{	MDstruct MD;
+	byte buf[64];	/* MDupdate reorders the bytes it is given */
+	MDbegin(&MD);
+	while (keylen >= 64)
+	{	memcpy(buf,key,64);
+		MDupdate(&MD,buf,512);
+		key += 64;
+		keylen -= 64;
+	}
+	memcpy(buf,key,keylen);
+	MDupdate(&MD,buf,(word32) keylen << 3);	/* finish with short block */
+	memcpy(hash,(byteptr) MD.buffer,16);
+	fillbuf(buf,sizeof(buf),0);	/* burn sensitive data on stack */
+	fillbuf((byteptr) &MD,sizeof(MD),0);
+} /* hashkey */
+
+
+/*
+**	burnentry - burn one entry of the key schedule cache, emptying it.
+*/
+static void burnentry(KEYCACHE FAR *entry)
+{	register byte FAR *p = (byte FAR *) entry;
+	register word16 n = sizeof(KEYCACHE);
+	do *p++ = 0; while (--n);
+} /* burnentry */
+
+
+/*
+**	getcachedkey - look for key in the key schedule cache, and copy its
+**	key context to kc if it's there.  Returns TRUE if it was found.
+*/
+static boolean getcachedkey(KEYCONTEXT *kc, byteptr key, short keylen, 
+	boolean decryp)
+{	short i,j;
+	byte hash[16];
+	if (keycache == NULL)
+		return(FALSE);	/* nothing cached yet */
+	hashkey(key,keylen,hash);
+	for (i=0; i<KEYCACHESIZE; i++)
+		if (keycache[i].lastuse && keycache[i].keylen == keylen 
+			&& keycache[i].decryp == decryp)
+		{	for (j=0; j<16 && keycache[i].keyhash[j] == hash[j]; j++)
+				;	/* compare digests */
+			if (j == 16)
+			{	*kc = keycache[i].context;
+				keycache[i].lastuse = ++keycache_clock;
+				fillbuf(hash,16,0);
+				return(TRUE);
+			}
+		}
+	fillbuf(hash,16,0);	/* burn sensitive data on stack */
+	return(FALSE);
+} /* getcachedkey */
+
+
+/*
+**	cachekey - remember the key context kc just built from key, in place
+**	of the least recently used entry in the key schedule cache.
+*/
+static void cachekey(KEYCONTEXT *kc, byteptr key, short keylen, 
+	boolean decryp)
+{	short i,oldest;
+	if (keycache == NULL)
+	{	keycache = FarAlloc(KEYCACHESIZE,sizeof(KEYCACHE));
+		if (keycache == NULL)
+			return;	/* no room, so don't cache anything */
+		for (i=0; i<KEYCACHESIZE; i++)
+			burnentry(&keycache[i]);	/* all entries empty */
+	}
+	oldest = 0;
+	for (i=1; i<KEYCACHESIZE; i++)
+		if (keycache[i].lastuse < keycache[oldest].lastuse)
+			oldest = i;
+	burnentry(&keycache[oldest]);
+	keycache[oldest].context = *kc;
+	hashkey(key,keylen,keycache[oldest].keyhash);
+	keycache[oldest].keylen = keylen;
+	keycache[oldest].decryp = decryp;
+	keycache[oldest].lastuse = ++keycache_clock;
+} /* cachekey */
+#endif	/* NOKEYCACHE */
+
+
+/*
+**	bass_flushcache - burn all the key schedules bass_initkey remembers
+*/
+void bass_flushcache(void)
+{
+#ifndef NOKEYCACHE
+	short i;
+	if (keycache != NULL)
+	{	for (i=0; i<KEYCACHESIZE; i++)
+			burnentry(&keycache[i]);
+		FarFree(keycache);
+		keycache = NULL;
+	}
+	keycache_clock = 0;
+#endif
+} /* bass_flushcache */
+
+
+static char *copyright_notice(void)
+/* force linker to include copyright notice in the executable object image. */
+{ return ("(c)1988 Philip Zimmermann"); } /* copyright_notice */
+
+
+/*
+**	bass_initkey - Initializes the BassOmatic key schedule tables via key.
+**
+**	References context variables from key context structure, all of them.
+**
+**	Uses several bits from the first byte of the key to select
+**	how exhaustivly to run the BassOmatic.  The key control bits
+**	specify what tradeoff to make between speed and security.
+**	These bits in the first byte of the key have these meanings:
+**	bits 0-2: Number of rounds thru BassOmatic (0-7 means 1-8
+**		times through).  The greater the number, the slower
+**		it runs.
+**	bit 3:  Set to 1 if we should use slower 8-way bit shredding,
+**		Set to 0 if we should use faster 50% bitmask shredding.
+**	bit 4:	Set to 1 means use BassOmatic to build its own tables.
+**	bit 5:  Set to 1 iff we should rebuild tables with every block.
+**		This implicitly disables bit 4, above.
+**	bits 6-7:  Reserved.
+**
+**	Key control bit 4 enables a two-tiered key schedule table
+**	generation.  The first set of tables are generated in the usual
+**	way with a linear feedback shift register (LFSR).  Then, a new
+**	set of tables is regenerated with a far better pseudo-random
+**	number generator--namely, the BassOmatic running off the first
+**	set of tables.  The BassOmatic pseudo-random number generator
+**	feeds its output back into itself to generate a stream of
+**	random blocks.  It is seeded with the same raw key that
+**	seeded the LFSR.  When the new set of tables are built, they
+**	replace the first set as the working tables.
+**
+**	Key control bit 5 keeps running the pseudorandom number generator
+**	to continuously rebuild the key schedule tables for each block of text.
+**	It automatically turns off key control bit 4.  Continuously replenishing
+**	the tables greatly slows down everything, but it improves security
+**	significantly.  This mode unfortunately also makes using the BassOmatic
+**	in the DES-like cipher block chaining (CBC) and cipher feedback (CFB)
+**	modes non-self-synchronizing.
+*/
+int bass_initkey(KEYCONTEXT *kc, byteptr key, short keylen, boolean decryp)
+/*	kc is the key context to set up.
+	key is pointer to key buffer, up to 256 bytes long.
+	keylen is length of key buffer, including key control byte.
+	decryp is TRUE if decrypting, FALSE if encrypting.
+*/
+{
+	if (key == NULL) /* initkey(nil,0,0) is harmless, and does nothing */
+		return(0);
+
+	if (keylen < 2)
+	{	/* key must have control byte and nonzero body length */
+		fprintf(stderr,"\nError: BassOmatic key too short.\n\007");
+		return(-1);	/* error return */
+	}
+
+	bass_close(kc);	/* burn any previous key schedule */
+
+	if (keylen > 255) keylen=255;
+#ifndef NOKEYCACHE
+	if (getcachedkey(kc,key,keylen,decryp))
+		return(0);	/* the tables were already built */
+#endif
+
+	kc->initialized = TRUE;	/* set already initialized flag */
+
+	kc->nrounds = (*key & 0x07) + 1; /* specifies number of rounds */
+	kc->shred8ways = ((*key & 0x08) != 0); /* use 8-way bit shredding? */
+	kc->rerand = ((*key & 0x20) != 0); /* replenish tables with every block */
+	/* hardrand means use BassOmatic table generator... */
+	kc->hardrand = ((*key & 0x10) != 0) && !kc->rerand;
+	kc->uncryp = FALSE;	/* initially assume encrypt, in case of hardrand */
+
+#ifdef DEBUG3
+	if (decryp)	/* use inverted tables for decryption */
+		fprintf(stderr,"Decrypt, ");
+	else		/* use non-inverted tables for encryption */
+		fprintf(stderr,"Encrypt, ");
+	fprintf(stderr,"%x rounds, ",kc->nrounds);
+	if (kc->hardrand)	/* BassOmatic random number generator */
+		fprintf(stderr,"hard ");
+	else		/* LFSR random number generator */
+		fprintf(stderr,"LFSR ");
+	if (kc->rerand)	/* rebuild tables for every block */
+		fprintf(stderr,"dynamic ");
+	else		/* keep same tables throughout message */
+		fprintf(stderr,"static ");
+	fprintf(stderr,"tables, ");
+	
+	if (kc->shred8ways)
+		fprintf(stderr,"8-way bitshred.\n");
+	else
+		fprintf(stderr,"2-way bitshred.\n");
+#endif	/* DEBUG3 */
+
+	/* init LFSR random number generator with key seed */
+	/* Assume actual key starts after 1st byte, which is control byte */
+	initlfsr(key+1,keylen-1,kc->lfsr,&kc->rtail);
+	/* dumpblock(kc->lfsr); */
+
+	buildtbl(kc,kc->tlist[0],FALSE); /* build throwaway table to prime the LFSR */
+
+	/* generate all the permutation tables for the key schedule */
+	if (!kc->rerand)	/* don't do it now if it's going to be redone anyway */
+		bldtbls(kc,FALSE,decryp && !kc->hardrand);
+
+	/* if hardrand, rebuild tables again, this time with BassOmatic */
+	if (kc->hardrand)	/* rebuild tables with BassOmatic */
+	{	/* form progressivly better bassrand function. */
+		/* init BassOmatic pseudo-random generator */
+		initbrand(kc,key+1,keylen-1); /* skip 1st key byte */
+		bldtbls(kc,kc->hardrand,decryp);/* generate all the tables again */
+		closebrand(kc);	/* wipe scratch buffer for bassrand */
+	} /* if (hardrand) */
+	kc->uncryp = decryp;	/* specifies BassOmatic decrypt or encrypt */
+
+	if (!kc->rerand)	/* if we don't need lfsr buffer anymore, then burn it. */
+		fillbuf(kc->lfsr,256,0); /* sure hope we don't use lfsr again */
+
+#ifndef NOKEYCACHE
+	cachekey(kc,key,keylen,decryp);
+#endif
+
+	/* Do an explicit reference to the copyright notice so that the linker 
+	   will be forced to include it in the executable object image... */
+	copyright_notice();	/* has no real effect at run time */
+	return(0);	/* normal return */
+} /* bass_initkey */
+
+
+/*
+**	initkey - Initializes the key schedule tables of the single 
+**	BassOmatic key context used by bassomatic() and basscfb().
+*/
+int initkey(byteptr key, short keylen, boolean decryp)
+{	return(bass_initkey(&thecontext,key,keylen,decryp));
+} /* initkey */
+
+
+/* Now for the primitives called directly from the BassOmatic algorithm...*/
+
+
+/*
+**	shred1bit - 8-way random bit shred
+**
+**	Tears each byte into 8 bits, and randomly distributes the bits.
+**	Uses 8 different permutation vectors from tlist.
+**	Unfortunately, it always uses the same 8 tables.
+*/
+STATIC void shred1bit(KEYCONTEXT *kc, register byteptr in, register byteptr out)
+/*	kc is the key context.
+	in and out are input, output blocks, 256 bytes each. */
+{	register bytecounter i;
+	register byteptr idx;	/* where each bit of an output byte is from */
+	/*	Bit 7-j of in[k] goes to out[tlist[j][k]].  Rather than scatter
+		the bits a bit plane at a time, with 8 passes that each read and
+		rewrite all of out, gather each output byte in one go, from the 
+		8 input bytes the inverted tables in shredidx say it comes from.
+		Gives exactly the same output as scattering. */
+	idx = kc->shredidx[0];
+	i = 256;	/* byte loop counter */
+	do
+	{	*out++ = (in[idx[0]] & 0x80) | (in[idx[1]] & 0x40)
+			| (in[idx[2]] & 0x20) | (in[idx[3]] & 0x10)
+			| (in[idx[4]] & 0x08) | (in[idx[5]] & 0x04)
+			| (in[idx[6]] & 0x02) | (in[idx[7]] & 0x01);
+		idx += NTABLES;
+	} while (--i);	/* loop 256 times */
+}	/* shred1bit */
+
+
+/*
+**	shred4bit - 2-way random bit shred
+**
+**	Tears each byte in half, and randomly distributes the halves.
+*/
+STATIC void shred4bit(register byteptr in, register byteptr out, 
+	register byteptr t1, register byteptr t2, register byte bitmask)
+/*	in and out are input, output blocks, 256 bytes each.
+	t1 and t2 each contain random permutation of 256 bytes.
+	bitmask is byte which has 50% of its bits set.
+*/
+{	register bytecounter i;
+	byteptr insave;		/* for saving input buffer pointer */
+	insave = in;		/* save input buffer pointer */
+	i = 64;			/* loop counter, 4 bytes per loop */
+	do			/* isolate half the bits */
+	{	out[t1[0]] = in[0] & bitmask;
+		out[t1[1]] = in[1] & bitmask;
+		out[t1[2]] = in[2] & bitmask;
+		out[t1[3]] = in[3] & bitmask;
+		t1 += 4; in += 4;
+	} while (--i);		/* loop 64 times */
+	in = insave;		/* recover input buffer pointer */
+	bitmask = ~bitmask;	/* invert bitmask for other half */
+	i = 64;			/* loop counter, 4 bytes per loop */
+	do		/* isolate other half and combine the two halfs */
+	{	out[t2[0]] |= in[0] & bitmask;
+		out[t2[1]] |= in[1] & bitmask;
+		out[t2[2]] |= in[2] & bitmask;
+		out[t2[3]] |= in[3] & bitmask;
+		t2 += 4; in += 4;
+	} while (--i);		/* loop 64 times */
+}	/* shred4bit */
+
+
+/*
+**	xortable - change block via xor with random table
+**
+**	This function would serve as its own inverse, if the table is the 
+**	same each time.  For use with an inverted table, call ixortable.
+**	This function inverts 50% of the bits.
+*/
+STATIC void xortable(register byteptr in, register byteptr out, 
+	register byteptr table)
+/*	in and out are input, output blocks, 256 bytes each, and may be
+	the same block.
+	table contains random permutation of 256 bytes.
+*/
+{	register bytecounter i;
+	if (wordaligned(in) && wordaligned(out) && wordaligned(table))
+	{	i = BLOCKWORDS;	/* word loop counter */
+		do	/* table xor, a word at a time */
+		{	putword(out,getword(in) ^ getword(table));
+			out += sizeof(blockword);
+			in += sizeof(blockword);
+			table += sizeof(blockword);
+		} while (--i);	/* loop 256/sizeof(blockword) times */
+		return;
+	}
+	i = 256;	/* byte loop counter */
+	do	*out++ = *in++ ^ *table++;	/* table xor */
+	while (--i);	/* loop 256 times */
+}	/* xortable */
+
+
+/*
+**	ixortable - change block via xor with inverted random table
+**
+**	This function inverts 50% of the bits.  It is the inverse function
+**	for xortable, if the table is inverted.  Used for decryption.
+*/
+STATIC void ixortable(register byteptr block, register byteptr table)
+/*	block is a 256 byte block.
+	table contains random permutation of 256 bytes.
+*/
+{	register bytecounter i;
+	i = 0;		/* loop index i = 0,4,8,...252 */
+	do	/* inverted table xor, 4 bytes per loop */
+	{	block[table[i]]   ^= (byte) i;
+		block[table[i+1]] ^= (byte) (i+1);
+		block[table[i+2]] ^= (byte) (i+2);
+		block[table[i+3]] ^= (byte) (i+3);
+	} while ((i += 4) < 256);	/* loop 64 times */
+}	/* ixortable */
+
+
+/*
+**	xorshred4bit - xor with random table, then 2-way random bit shred
+**
+**	Does the same as xortable(in,block,t0) followed by 
+**	shred4bit(block,out,t1,t2,bitmask), but in 2 passes instead of 3.
+**	This is the first half of an encryption round with 2-way shredding.
+*/
+STATIC void xorshred4bit(register byteptr in, register byteptr block, 
+	byteptr out, byteptr t0, byteptr t1, byteptr t2, byte bitmask)
+/*	in is input block, block gets in xor t0, and may be the same as in.
+	out is output block.  All blocks are 256 bytes.
+	t0, t1 and t2 each contain random permutation of 256 bytes.
+	bitmask is byte which has 50% of its bits set.
+*/
+{	register bytecounter i;
+	byte x;
+	i = 256;		/* byte loop counter */
+	do	/* xor with table, and isolate half the bits */
+	{	x = *in++ ^ *t0++;
+		*block++ = x;
+		out[*t1++] = x & bitmask;
+	} while (--i);		/* loop 256 times */
+	block -= 256;		/* recover block pointer */
+	bitmask = ~bitmask;	/* invert bitmask for other half */
+	i = 64;			/* loop counter, 4 bytes per loop */
+	do		/* isolate other half and combine the two halfs */
+	{	out[t2[0]] |= block[0] & bitmask;
+		out[t2[1]] |= block[1] & bitmask;
+		out[t2[2]] |= block[2] & bitmask;
+		out[t2[3]] |= block[3] & bitmask;
+		t2 += 4; block += 4;
+	} while (--i);		/* loop 64 times */
+}	/* xorshred4bit */
+
+
+/*
+**	rakelookup - rake forwards and backwards with xor and add, then 
+**	change via multiple substitution tables
+**
+**	Raking is not a keyed operation.  It is only useful for increasing
+**	the intersymbol dependencies between the plaintext and the ciphertext,
+**	not the key and the ciphertext.  Each byte is final as soon as the 
+**	backward rake reaches it, so the substitution is done in the same 
+**	pass.  This is the second half of an encryption round.  Its inverse 
+**	is lookupunrake.
+*/
+STATIC void rakelookup(KEYCONTEXT *kc, register byteptr block, 
+	register byteptr out, byte ti)
+/*	kc is the key context.
+	block is input block, which gets raked, out is output block,
+	256 bytes each.
+	ti contains index into starting point of tlist.
+*/
+{	register byte i;
+	register byteptr table;
+	byte carry, j;
+	i = 255;	/* loop 255 times */
+	/* first do forward raking with cumulative xor */
+	do	/*  from  *1 ^= *0;  thru  *255 ^= *254; */
+	{	block[1] ^= block[0];
+		block++;
+	} while (--i);
+	/* now block = 255, relatively speaking */
+	/* now do backward raking with cumulative add, substituting each
+	   byte via the table for its 32-byte group as it is finished */
+	out += 256;
+	block++;
+	carry = 0;	/* nothing to add to 255 */
+	j = 8;
+	do
+	{	table = kc->tlist[(ti + j - 1) & 7];	/* assumes 8 tables */
+		i = 32;
+		do	/* from 255 += 0; thru 0 += 1 */
+		{	carry += *(--block);
+			*(--out) = table[carry];	/* multi-table substitute */
+		} while (--i);	/* loop 32 times */
+	} while (--j);	/* loop 8 times */
+}	/* rakelookup */
+
+
+/*
+**	lookupunrake - change input via multiple substitution tables, then
+**	unrake forwards and backwards with subtract and xor
+**
+**	This is the inverse function of rakelookup.  Used for decryption.
+**	Unraking each byte only needs its neighbors as they were before 
+**	the unrake, so both directions are done in one pass.
+*/
+STATIC void lookupunrake(KEYCONTEXT *kc, register byteptr in, 
+	register byteptr out, byte ti)
+/*	kc is the key context.
+	in and out are input, output blocks, 256 bytes each.
+	ti contains index into starting point of tlist.
+*/
+{	register byteptr table;
+	register byte i;
+	byte j, cur, next, diff, prevdiff;
+	j=8;
+	do
+	{	table = kc->tlist[ti++ & 7];	/* assumes 8 tables */
+		i=8;
+		do	/* multi-table substitute, 4 bytes per loop */
+		{	out[0] = table[in[0]];
+			out[1] = table[in[1]];
+			out[2] = table[in[2]];
+			out[3] = table[in[3]];
+			out += 4; in += 4;
+		} while (--i);	/* loop 8 times */
+	}
+	while (--j);	/* loop 8 times */
+	out -= 256;	/* recover output buffer pointer */
+	/* The forward unrake subtracts each byte's old successor from it,
+	   and then the backward unrake xors in its old predecessor. */
+	prevdiff = 0;	/* 0 has no predecessor */
+	cur = out[0];
+	i = 255;	/* loop 255 times */
+	do	/* from 0 thru 254 */
+	{	next = out[1];
+		diff = cur - next;	/* forward unrake */
+		*out++ = diff ^ prevdiff;	/* backward unrake */
+		prevdiff = diff;
+		cur = next;
+	} while (--i);
+	*out = cur ^ prevdiff;	/* 255 has no successor */
+}	/* lookupunrake */
+
+
+#define f(i,j) (((i)+(j)) & 7)	/* used for circular addressing mod 8 */
+#define tl(i,j) kc->tlist[f(i,j)]	/* assumes 8 tables */
+
+
+/*
+**	bass_block - encipher 1 block with BassOmatic enciphering algorithm
+**
+**	Assumes bass_initkey has already been called for kc.
+**	References context variables tlist, nrounds, shred8ways,
+**	bitmasks, uncryp, and rerand.
+*/
+void bass_block(KEYCONTEXT *kc, byteptr in, byteptr out)
+/*	kc is the key context.
+	in and out are input, output blocks, 256 bytes each.
+	in and out may be the same block.
+*/
+{	char i;		/* signed char */
+	blockword tmpw[BLOCKWORDS];	/* word aligned */
+	byteptr tmp = (byteptr) tmpw;
+
+	if (kc->rerand)	/* dynamic replenishment of tables? */
+		bldtbls(kc,FALSE,kc->uncryp);
+
+	/* The first round reads from in, and later rounds from out. */
+	if (kc->uncryp)
+	{ 	/* do decryption */
+		for (i=kc->nrounds-1; i>=0; i--)	/* repeat a few rounds */
+		{	lookupunrake(kc,in,tmp,f(i,2));
+			if (kc->shred8ways)	/* use 8-way bit shredding */
+				shred1bit(kc,tmp,out);
+			else			/* use faster 2-way bit shredding */
+				shred4bit(tmp,out,tl(i,1),tl(i,5),
+					kc->bitmasks[f(i,3)]);
+			ixortable(out,tl(i,0));	/* inverts 50% of bits */
+			in = out;
+		} /* for loop */
+	}	/* if decryption */
+	else	/* do encryption */
+	{	for (i=0; i<kc->nrounds; i++)	/* repeat a few rounds */
+		{	if (kc->shred8ways)	/* use 8-way bit shredding */
+			{	xortable(in,out,tl(i,0));	/* inverts 50% of bits */
+				shred1bit(kc,out,tmp);
+			}
+			else			/* use faster 2-way bit shredding */
+				xorshred4bit(in,out,tmp,tl(i,0),tl(i,1),tl(i,5),
+					kc->bitmasks[f(i,3)]);
+			rakelookup(kc,tmp,out,f(i,2));
+			in = out;
+		} /* for loop */
+	}	/* else encryption */
+	fillbuf(tmp,256,0);	/* burn the evidence */
+}	/* bass_block */
+
+
+/*
+**	bassomatic - encipher 1 block with BassOmatic enciphering algorithm,
+**	using the key context set up by initkey.
+*/
+void bassomatic(byteptr in, byteptr out)
+/*	in and out are input, output blocks, 256 bytes each. */
+{	bass_block(&thecontext,in,out);
+}	/* bassomatic */
+
+
+/*
+**	xorbuf - change buffer via xor with random mask block
+**	Used for Cipher Feedback (CFB) or Cipher Block Chaining
+**	(CBC) modes of encryption.
+**	Can be applied for any block encryption algorithm,
+**	such as the DES or the BassOmatic.
+*/
+STATIC void xorbuf(register byteptr buf, register byteptr mask, register int count)
+/*	count must be > 0 */
+{	if (wordaligned(buf) && wordaligned(mask))
+	{	register int words = count / sizeof(blockword);
+		while (words--)	/* xor a word at a time */
+		{	putword(buf,getword(buf) ^ getword(mask));
+			buf += sizeof(blockword);
+			mask += sizeof(blockword);
+		}
+		if ((count %= sizeof(blockword)) == 0)
+			return;
+	}
+	do
+		*buf++ ^= *mask++;
+	while (--count);
+}	/* xorbuf */
+
+
+/*
+**	cfbshift - shift bytes into IV for CFB input
+**	Used only for Cipher Feedback (CFB) mode of encryption.
+**	Can be applied for any block encryption algorithm,
+**	such as the DES or the BassOmatic.
+*/
+STATIC void cfbshift(register byteptr iv, register byteptr buf, 
+		register int count, int blocksize)
+/* 	iv is the initialization vector.
+	buf is the buffer pointer.
+	count is the number of bytes to shift in...must be > 0.
+	blocksize is 8 for DES, 256 for BassOmatic.
+*/
+{	int retained;
+	retained = blocksize-count;	/* number bytes in iv to retain */
+	/* left-shift retained bytes of IV over by count bytes to make room */
+	while (retained--)
+	{	*iv = *(iv+count);
+		iv++;
+	}
+	/* now copy count bytes from buf to shifted tail of IV */
+	do	*iv++ = *buf++;
+	while (--count);
+}	/* cfbshift */
+
+
+#define BLOCKSIZE 256	/* encryption block size for CFB mode. */
+
+/*
+**	bass_initcfb - Initializes the BassOmatic key schedule tables via key,
+**	and initializes the Cipher Feedback mode IV.
+**	References context variables cfbuncryp and iv.
+*/
+int bass_initcfb(KEYCONTEXT *kc, byteptr iv0, byteptr key, short keylen, 
+	boolean decryp)
+/* 	kc is the key context to set up.
+	iv0 is copied to context iv, buffer will be destroyed by bass_cfb.
+	key is pointer to key buffer, up to 256 bytes long.
+	keylen is length of key buffer.
+	decryp is TRUE if decrypting, FALSE if encrypting.
+*/
+{	int status;
+	status = bass_initkey(kc,key,keylen,FALSE);
+	kc->iv = iv0;	/* iv belongs to the caller, not the context */
+	kc->cfbuncryp = decryp;
+	return (status);
+} /* bass_initcfb */
+
+
+/*
+**	bass_cfb - encipher 1 block with BassOmatic enciphering algorithm,
+**		using Cipher Feedback (CFB) mode.
+**
+**	Assumes bass_initcfb has already been called for kc.
+**	References context variables cfbuncryp and iv.
+*/
+void bass_cfb(KEYCONTEXT *kc, byteptr buf, int count)
+/*	kc is the key context.
+	buf is input, output buffer, may be more than 1 block.
+	count is byte count of buffer.  May be > BLOCKSIZE.
+*/
+{	int chunksize;	/* smaller of count, BLOCKSIZE */
+	int nblocks;	/* number of whole blocks in buf */
+	blockword tempw[BLOCKSIZE/sizeof(blockword)];	/* word aligned */
+	blockword firstw[BLOCKSIZE/sizeof(blockword)];	/* word aligned */
+	byteptr temp = (byteptr) tempw;
+	byteptr first = (byteptr) firstw;
+
+	/*	When decrypting, the keystream for each whole block is just the 
+		ciphertext block before it, enciphered, and all the ciphertext 
+		is here already.  So the whole blocks can be decrypted last to 
+		first, straight from buf, without shifting each one into the 
+		IV.  Tables that change with every block must see the blocks 
+		in order, so rerand keys take the usual path.
+	*/
+	if (kc->cfbuncryp && !kc->rerand && count >= BLOCKSIZE)
+	{	nblocks = count / BLOCKSIZE;
+		bass_block(kc,kc->iv,first); /* keystream for first block */
+		/* last ciphertext block becomes the IV for what follows */
+		copy256(kc->iv,buf+(nblocks-1)*BLOCKSIZE);
+		while (--nblocks)
+		{	bass_block(kc,buf+(nblocks-1)*BLOCKSIZE,temp);
+			xorbuf(buf+nblocks*BLOCKSIZE,temp,BLOCKSIZE);
+		}
+		xorbuf(buf,first,BLOCKSIZE);
+		fillbuf(first,BLOCKSIZE,0);	/* burn the evidence */
+		buf += count - count % BLOCKSIZE;
+		count %= BLOCKSIZE;
+	}
+
+	while ((chunksize = min(count,BLOCKSIZE)) > 0)
+	{	bass_block(kc,kc->iv,temp); /* encrypt iv. */
+
+		if (kc->cfbuncryp)	/* buf is ciphertext */
+			/* shift in ciphertext to IV... */
+			cfbshift(kc->iv,buf,chunksize,BLOCKSIZE);
+
+		/* convert buf via xor */
+		xorbuf(buf,temp,chunksize); /* buf now has enciphered output */
+
+		if (!kc->cfbuncryp)	/* buf was plaintext, is now ciphertext */
+			/* shift in ciphertext to IV... */
+			cfbshift(kc->iv,buf,chunksize,BLOCKSIZE);
+
+		count -= chunksize;
+		buf += chunksize;
+	}
+	fillbuf(temp,BLOCKSIZE,0);	/* burn the evidence */
+} /* bass_cfb */
+
+
+/*
+**	initcfb - Initializes the single BassOmatic key context used by 
+**	basscfb, and initializes the Cipher Feedback mode IV.
+*/
+int initcfb(byteptr iv0, byteptr key, short keylen, boolean decryp)
+{	return(bass_initcfb(&thecontext,iv0,key,keylen,decryp));
+} /* initcfb */
+
+
+/*
+**	basscfb - encipher with BassOmatic in Cipher Feedback (CFB) mode, 
+**	using the key context set up by initcfb.
+*/
+void basscfb(byteptr buf, int count)
+{	bass_cfb(&thecontext,buf,count);
+} /* basscfb */
+
+
+/*
+**	bass_initctr - Initializes the BassOmatic key schedule tables via key,
+**	and initializes the counter block for counter (CTR) mode.
+*/
+int bass_initctr(KEYCONTEXT *kc, byteptr ctr0, byteptr key, short keylen)
+/* 	kc is the key context to set up.
+	ctr0 is the first counter block, 256 bytes, usually a nonce followed
+	by zeros.  It will be counted up by bass_ctr.
+	key is pointer to key buffer, up to 256 bytes long.
+	keylen is length of key buffer.
+*/
+{	int status;
+	status = bass_initkey(kc,key,keylen,FALSE);
+	kc->iv = ctr0;	/* counter block belongs to the caller */
+	kc->ctrleft = 0;	/* no keystream yet */
+	return (status);
+} /* bass_initctr */
+
+
+/*
+**	bass_ctr - encipher with BassOmatic enciphering algorithm,
+**		using counter (CTR) mode.
+**
+**	Each block of keystream is the counter block enciphered, and the
+**	counter block is counted up by one after each block.  Since the 
+**	keystream doesn't depend on the text, enciphering and deciphering 
+**	are the same, and no block of text has to wait for the one before it.
+**	Assumes bass_initctr has already been called for kc.
+**	References context variables iv, ctrbuf and ctrleft.
+*/
+void bass_ctr(KEYCONTEXT *kc, byteptr buf, int count)
+/*	kc is the key context.
+	buf is input, output buffer, may be more than 1 block.
+	count is byte count of buffer.  May be > BLOCKSIZE.
+*/
+{	int chunksize;	/* smaller of count, keystream on hand */
+	short i;
+
+	while (count > 0)
+	{	if (kc->ctrleft == 0)	/* keystream block is spent */
+		{	bass_block(kc,kc->iv,kc->ctrbuf);
+			/* count up the counter block, treated as MSB-first */
+			i = BLOCKSIZE;
+			while (i-- && ++kc->iv[i] == 0)
+				;	/* propagate carry */
+			kc->ctrleft = BLOCKSIZE;
+		}
+		chunksize = min(count,(int) kc->ctrleft);
+		xorbuf(buf,kc->ctrbuf+BLOCKSIZE-kc->ctrleft,chunksize);
+		kc->ctrleft -= chunksize;
+		count -= chunksize;
+		buf += chunksize;
+	}
+} /* bass_ctr */
+
+
+/*
+**	initctr - Initializes the single BassOmatic key context used by 
+**	bassctr, and initializes the counter (CTR) mode counter block.
+*/
+int initctr(byteptr ctr0, byteptr key, short keylen)
+{	return(bass_initctr(&thecontext,ctr0,key,keylen));
+} /* initctr */
+
+
+/*
+**	bassctr - encipher or decipher with BassOmatic in counter (CTR) mode, 
+**	using the key context set up by initctr.
+*/
+void bassctr(byteptr buf, int count)
+{	bass_ctr(&thecontext,buf,count);
+} /* bassctr */
+
+
+/*
+**	initbassrand - initialize bassrand, BassOmatic random number generator,
+**	using the key context otherwise used by initkey and basscfb.
+**	Must close via closebass().
+*/
+void initbassrand(byteptr key, short keylen, byteptr seed, short seedlen)
+{	bass_initrand(&thecontext,key,keylen,seed,seedlen);
+} /* initbassrand */
+
+
+/*
+**	bassrand - BassOmatic pseudo-random number generator
+*/
+byte bassrand(void)
+{	return(bass_rand(&thecontext));
+} /* bassrand */
+
+
+/*
+**	bassrand_fill - fill a buffer from bassrand, using the key context
+**	set up by initbassrand.
+*/
+void bassrand_fill(byteptr buf, int count)
+{	bass_randfill(&thecontext,buf,count);
+} /* bassrand_fill */
+
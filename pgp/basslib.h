@@ -1,121 +1,223 @@
-/*	basslib.h - include file for BassOmatic encipherment functions.
-
-	(c) Copyright 1988 by Philip Zimmermann.  All rights reserved.  
-	This software may not be copied without the written permission of 
-	Philip Zimmermann.  The author assumes no liability for damages
-	resulting from the use of this software, even if the damage results
-	from defects in this software.  No warranty is expressed or implied.
-*/
-
-/* Elaborate protection mechanisms to assure no redefinitions of types...*/
-#ifndef BOOLSTUFF
-#define BOOLSTUFF
-#ifndef TRUE
-#define FALSE 0
-#define TRUE (!FALSE)
-#endif	/* if TRUE not already defined */
-typedef unsigned char boolean;	/* values are TRUE or FALSE */
-#endif	/* if BOOLSTUFF not already defined */
-#ifndef BYTESTUFF
-#define BYTESTUFF
-typedef unsigned char byte;	/* values are 0-255 */
-typedef byte *byteptr;	/* pointer to byte */
-typedef char *string;	/* pointer to ASCII character string */
-#endif	/* if BYTESTUFF not already defined */
-#ifndef WORDSTUFF
-#define WORDSTUFF
-typedef unsigned short word16;	/* values are 0-65536 */
-typedef unsigned long word32;	/* values are 0-4294967296 */
-#endif	/* if WORDSTUFF not already defined */
-#ifndef min	/* if min macro not already defined */
-#define min(a,b) ( (a)<(b) ? (a) : (b) )
-#define max(a,b) ( (a)>(b) ? (a) : (b) )
-#endif	/* if min macro not already defined */
-
-
-#define MAXKEYLEN 254	/* max byte length of BassOmatic key */
-
-#define NTABLES 8		/* number of random permutation vectors */
-
-typedef struct {
-	boolean	initialized;	/* determines whether key context is defined */
-	byteptr	tlist[NTABLES];	/* list of permutation table pointers */
-	byte	bitmasks[NTABLES]; /* bitshredder bitmasks with 50% bits set */
-	byteptr	iv; /* CFB Initialization Vector used by initcfb and basscfb */
-	boolean cfbuncryp;	/* TRUE means decrypting (in CFB mode) */
-	boolean uncryp;		/* TRUE means decrypting (in ECB mode) */
-/* The following parameters are computed from the key control byte...*/
-	char	nrounds;	/* specifies number of rounds thru BassOmatic */
-	boolean hardrand;	/* means regenerate tables with BassOmatic */
-	boolean shred8ways;	/* means use 8-way bit shredding */
-	boolean rerand;		/* means replenish tables with every block */
-	byteptr	lfsr;		/* Linear Feedback Shift Register */
-	byte	rtail;		/* rtail is an index into LFSR buffer */
-	} KEYCONTEXT;
-
-
-/*
-**	initbassrand - initialize bassrand, BassOmatic random number generator.
-**		Must close via closebass().
-*/
-void initbassrand(byteptr key, short keylen, byteptr seed, short seedlen);
-
-
-/*
-**	bassrand - BassOmatic pseudo-random number generator.
-*/
-byte bassrand(void);
-
-
-/*
-**	bass_save - saves BassOmatic key context in context structure.
-*/
-void bass_save(KEYCONTEXT *context);
-
-
-/*
-**	bass_restore - restore BassOmatic key context from context structure.
-*/
-void bass_restore(KEYCONTEXT *context);
-
-
-/*
-**	closebass - end the current BassOmatic key context, freeing its buffers.
-*/
-void closebass(void);
-
-int initkey(byteptr key, short keylen, boolean decryp);
-	/* Sets up key schedule for BassOmatic. */
-
-void bassomatic(byteptr in, byteptr out);
-	/* Encipher 1 block with the BassOmatic ECB mode. */
-
-/*
-**	initcfb - Initializes the BassOmatic key schedule tables via key,
-**	and initializes the Cipher Feedback mode IV.
-*/
-int initcfb(byteptr iv0, byteptr key, short keylen, boolean decryp);
-
-
-/*
-**	basscfb - encipher 1 block with BassOmatic enciphering algorithm,
-**		using Cipher Feedback (CFB) mode.
-**
-**	Assumes initcfb has already been called.  References global iv byteptr.
-*/
-void basscfb(byteptr buf, int count);
-
-
-/*
-**	fillbuf(dst,count,c) - fill byte buffer dst with byte c
-*/
-void fillbuf(register byteptr dst, register short count, register byte c);
-
-
-/*
-**	crc() - compute CRC-16 of buffer
-*/
-word16 crc(register byteptr buf, int count);
-
-
-
\ No newline at end of file
+/*	basslib.h - include file for BassOmatic encipherment functions.
+
+	(c) Copyright 1988 by Philip Zimmermann.  All rights reserved.  
+	This software may not be copied without the written permission of 
+	Philip Zimmermann.  The author assumes no liability for damages
+	resulting from the use of this software, even if the damage results
+	from defects in this software.  No warranty is expressed or implied.
+*/
+
+/* Elaborate protection mechanisms to assure no redefinitions of types...*/
+#ifndef BOOLSTUFF
+#define BOOLSTUFF
+#ifndef TRUE
+#define FALSE 0
+#define TRUE (!FALSE)
+#endif	/* if TRUE not already defined */
+typedef unsigned char boolean;	/* values are TRUE or FALSE */
+#endif	/* if BOOLSTUFF not already defined */
+#ifndef BYTESTUFF
+#define BYTESTUFF
+typedef unsigned char byte;	/* values are 0-255 */
+typedef byte *byteptr;	/* pointer to byte */
+typedef char *string;	/* pointer to ASCII character string */
+#endif	/* if BYTESTUFF not already defined */
+#ifndef WORDSTUFF
+#define WORDSTUFF
+typedef unsigned short word16;	/* values are 0-65536 */
+typedef unsigned long word32;	/* values are 0-4294967296 */
+#endif	/* if WORDSTUFF not already defined */
+#ifndef min	/* if min macro not already defined */
+#define min(a,b) ( (a)<(b) ? (a) : (b) )
+#define max(a,b) ( (a)>(b) ? (a) : (b) )
+#endif	/* if min macro not already defined */
+
+
+#define MAXKEYLEN 254	/* max byte length of BassOmatic key */
+
+#define NTABLES 8		/* number of random permutation vectors */
+
+/*	A KEYCONTEXT holds everything the BassOmatic needs for one key,
+	including its own tables, so any number of them may be in use at
+	once.  A KEYCONTEXT must be all zeros before its first use, as
+	static storage is, or else be passed to bass_close first.
+*/
+typedef struct {
+/* The 256-byte arrays come first, to keep them word aligned...*/
+	byte	tlist[NTABLES][256];	/* permutation tables */
+	byte	shredidx[256][NTABLES];	/* inverted tlist, for 8-way shredding */
+	byte	lfsr[256];	/* Linear Feedback Shift Register */
+	byte	randbuf[256];	/* buffer for bass_rand */
+	byte	ctrbuf[256];	/* keystream block for bass_ctr */
+	boolean	initialized;	/* determines whether key context is defined */
+	byte	bitmasks[NTABLES]; /* bitshredder bitmasks with 50% bits set */
+	byteptr	iv; /* CFB IV or CTR counter block, supplied by caller */
+	boolean cfbuncryp;	/* TRUE means decrypting (in CFB mode) */
+	boolean uncryp;		/* TRUE means decrypting (in ECB mode) */
+/* The following parameters are computed from the key control byte...*/
+	char	nrounds;	/* specifies number of rounds thru BassOmatic */
+	boolean hardrand;	/* means regenerate tables with BassOmatic */
+	boolean shred8ways;	/* means use 8-way bit shredding */
+	boolean rerand;		/* means replenish tables with every block */
+	byte	rtail;		/* rtail is an index into LFSR buffer */
+/* The following are used only by the BassOmatic random number generator...*/
+	boolean randopen;	/* TRUE means randbuf is in use */
+	byte	randbuf_counter; /* # of random bytes left in randbuf */
+	word16	ctrleft;	/* # of keystream bytes left in ctrbuf */
+	} KEYCONTEXT;
+
+
+/*
+**	bass_initkey - Sets up key schedule for BassOmatic in context kc.
+*/
+int bass_initkey(KEYCONTEXT *kc, byteptr key, short keylen, boolean decryp);
+
+/*
+**	bass_block - Encipher 1 block with the BassOmatic ECB mode, using kc.
+*/
+void bass_block(KEYCONTEXT *kc, byteptr in, byteptr out);
+
+/*
+**	bass_initcfb - Initializes the BassOmatic key schedule tables of kc
+**	via key, and initializes the Cipher Feedback mode IV.
+*/
+int bass_initcfb(KEYCONTEXT *kc, byteptr iv0, byteptr key, short keylen, 
+	boolean decryp);
+
+/*
+**	bass_cfb - encipher with BassOmatic in Cipher Feedback (CFB) mode,
+**		using kc.  Assumes bass_initcfb has already been called for kc.
+*/
+void bass_cfb(KEYCONTEXT *kc, byteptr buf, int count);
+
+/*
+**	bass_initctr - Initializes the BassOmatic key schedule tables of kc
+**	via key, and initializes the counter (CTR) mode counter block.
+*/
+int bass_initctr(KEYCONTEXT *kc, byteptr ctr0, byteptr key, short keylen);
+
+/*
+**	bass_ctr - encipher or decipher with BassOmatic in counter (CTR) mode,
+**		using kc.  Assumes bass_initctr has already been called for kc.
+*/
+void bass_ctr(KEYCONTEXT *kc, byteptr buf, int count);
+
+/*
+**	bass_initrand - initialize BassOmatic random number generator in kc.
+**		Must close via bass_close().
+*/
+void bass_initrand(KEYCONTEXT *kc, byteptr key, short keylen, 
+	byteptr seed, short seedlen);
+
+/*
+**	bass_rand - BassOmatic pseudo-random number generator, using kc.
+*/
+byte bass_rand(KEYCONTEXT *kc);
+
+/*
+**	bass_randfill - fill buf with count bytes from bass_rand, using kc.
+*/
+void bass_randfill(KEYCONTEXT *kc, byteptr buf, int count);
+
+/*
+**	bass_close - end a BassOmatic key context, burning its tables.
+*/
+void bass_close(KEYCONTEXT *kc);
+
+
+/*
+**	bass_flushcache - burn all the key schedules bass_initkey remembers.
+**		Call before exiting.
+*/
+void bass_flushcache(void);
+
+
+/*	The following functions all use a single key context of their own, 
+	for callers that need only one key at a time.
+*/
+
+/*
+**	initbassrand - initialize bassrand, BassOmatic random number generator.
+**		Must close via closebass().
+*/
+void initbassrand(byteptr key, short keylen, byteptr seed, short seedlen);
+
+
+/*
+**	bassrand - BassOmatic pseudo-random number generator.
+*/
+byte bassrand(void);
+
+
+/*
+**	bassrand_fill - fill buf with count bytes from bassrand.
+*/
+void bassrand_fill(byteptr buf, int count);
+
+
+/*
+**	bass_save - saves BassOmatic key context in context structure.
+*/
+void bass_save(KEYCONTEXT *context);
+
+
+/*
+**	bass_restore - restore BassOmatic key context from context structure.
+*/
+void bass_restore(KEYCONTEXT *context);
+
+
+/*
+**	closebass - end the current BassOmatic key context, freeing its buffers.
+*/
+void closebass(void);
+
+int initkey(byteptr key, short keylen, boolean decryp);
+	/* Sets up key schedule for BassOmatic. */
+
+void bassomatic(byteptr in, byteptr out);
+	/* Encipher 1 block with the BassOmatic ECB mode. */
+
+/*
+**	initcfb - Initializes the BassOmatic key schedule tables via key,
+**	and initializes the Cipher Feedback mode IV.
+*/
+int initcfb(byteptr iv0, byteptr key, short keylen, boolean decryp);
+
+
+/*
+**	basscfb - encipher 1 block with BassOmatic enciphering algorithm,
+**		using Cipher Feedback (CFB) mode.
+**
+**	Assumes initcfb has already been called.
+*/
+void basscfb(byteptr buf, int count);
+
+
+/*
+**	initctr - Initializes the BassOmatic key schedule tables via key,
+**	and initializes the counter (CTR) mode counter block.
+*/
+int initctr(byteptr ctr0, byteptr key, short keylen);
+
+
+/*
+**	bassctr - encipher or decipher with BassOmatic in counter (CTR) mode.
+**
+**	Assumes initctr has already been called.
+*/
+void bassctr(byteptr buf, int count);
+
+
+/*
+**	fillbuf(dst,count,c) - fill byte buffer dst with byte c
+*/
+void fillbuf(register byteptr dst, register short count, register byte c);
+
+
+/*
+**	crc() - compute CRC-16 of buffer
+*/
+word16 crc(register byteptr buf, int count);
+
+
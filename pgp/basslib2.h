@@ -1,9 +1,8 @@
-/*	basslib2.h - header file for basslib2.c
-	Assumes that basslib.h has already been included.
-*/
-
-int getpassword(char *keystring, byte noecho, int defaultc);
-	/*	Get Bassomatic pass phrase from user. */
-
-
-
\ No newline at end of file
+/*	basslib2.h - header file for basslib2.c
+	Assumes that basslib.h has already been included.
+*/
+
+int getpassword(char *keystring, byte noecho, int defaultc);
+	/*	Get Bassomatic pass phrase from user. */
+
+
@@ -0,0 +1,167 @@
+/*	basstime.c - Timing driver for the BassOmatic
+
+	Measures how long initkey takes to build the key schedule, and how
+	fast bassomatic and basscfb run, for each setting of the key control
+	byte, so that the settings used by make_random_basskey and the 0x1f
+	default for pass phrases can be chosen from real numbers rather than
+	from the comments in basslib.c.  The control byte selects:
+		bits 0-2:  number of rounds, less 1
+		bit 3:     8-way bit shredding, rather than 2-way
+		bit 4:     hardrand tables, made with the BassOmatic itself
+		bit 5:     rerand, new tables for every block
+	Each setting is timed for encryption and decryption, and basscfb
+	is timed with buffers of several sizes.  diskbufsize in pgp.c is
+	1024 bytes.  The key schedule cache is flushed before each initkey
+	that is timed, and initkey is also timed when the cache has the key.
+
+	The report is in JSON, one object per control byte, so that it can
+	be read by other programs.
+
+	Usage:  basstime [min_ms [control_byte]]
+
+	Each measurement is repeated until at least min_ms milliseconds 
+	have gone by, 1000 by default.  Without control_byte, every one of 
+	the 64 settings is timed, which takes a while.  control_byte may be 
+	given in hex, ie 0x1f.  Times are as fine as the C library
+	clock() allows, which is only 55 milliseconds on an IBM PC.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "basslib.h"
+
+#define KEYLEN 33	/* control byte and 32 byte key, as for -e */
+#define NSIZES 3	/* number of basscfb buffer sizes */
+#define MAXBUF 8192	/* biggest basscfb buffer */
+
+static short bufsizes[NSIZES] = { 256, 1024, MAXBUF };
+static byte buf[MAXBUF];	/* plaintext or ciphertext */
+static byte key[KEYLEN];
+static clock_t minticks;	/* least clock ticks for a measurement */
+
+
+static double initkey_ms(boolean decryp, boolean cached)
+/*	Returns milliseconds per initkey call for key.  Unless cached, the
+	key schedule cache is flushed first, so the tables are built.
+*/
+{	long calls;
+	clock_t start, ticks;
+
+	calls = 0;
+	initkey(key,KEYLEN,decryp);	/* cache it, in case cached */
+	start = clock();
+	do
+	{	if (!cached)
+			bass_flushcache();
+		initkey(key,KEYLEN,decryp);
+		calls++;
+	} while ((ticks = clock() - start) < minticks);
+	closebass();
+	return((double) ticks * 1000.0 / CLOCKS_PER_SEC / calls);
+}	/* initkey_ms */
+
+
+static double ecb_rate(boolean decryp)
+/*	Returns megabytes per second through bassomatic, one block at a
+	time, as bassrand uses it.
+*/
+{	long blocks;
+	clock_t start, ticks;
+
+	initkey(key,KEYLEN,decryp);
+	blocks = 0;
+	start = clock();
+	do
+	{	bassomatic(buf,buf);
+		blocks++;
+	} while ((ticks = clock() - start) < minticks);
+	closebass();
+	return((double) blocks * 256 / 1.0e6 / ((double) ticks / CLOCKS_PER_SEC));
+}	/* ecb_rate */
+
+
+static double cfb_rate(boolean decryp, short bufsize)
+/*	Returns megabytes per second through basscfb, with bufsize bytes
+	per call, as bass_file uses it.
+*/
+{	byte iv[256];
+	long calls;
+	clock_t start, ticks;
+
+	fillbuf(iv,256,0);
+	initcfb(iv,key,KEYLEN,decryp);
+	calls = 0;
+	start = clock();
+	do
+	{	basscfb(buf,bufsize);
+		calls++;
+	} while ((ticks = clock() - start) < minticks);
+	closebass();
+	return((double) calls * bufsize / 1.0e6 / ((double) ticks / CLOCKS_PER_SEC));
+}	/* cfb_rate */
+
+
+static void time_control(byte control, boolean last)
+/*	Times one key control byte setting and prints its JSON object. */
+{	boolean decryp;
+	short i;
+
+	key[0] = control;
+	printf("  { \"control\": \"0x%02x\", \"rounds\": %d, \"shred\": %d, ",
+		control, (control & 0x07) + 1, (control & 0x08) ? 8 : 2);
+	/* rerand tables are always made by the LFSR */
+	printf("\"tables\": \"%s\", \"rerand\": %s,\n",
+		(control & 0x10) && !(control & 0x20) ? "hardrand" : "lfsr",
+		(control & 0x20) ? "true" : "false");
+	for (decryp=FALSE; decryp<=TRUE; decryp++)
+	{	printf("    \"%s\": { \"initkey_ms\": %.3f, \"initkey_cached_ms\": %.4f, ",
+			decryp ? "decrypt" : "encrypt",
+			initkey_ms(decryp,FALSE), initkey_ms(decryp,TRUE));
+		printf("\"ecb_MBps\": %.4f,\n      \"cfb_MBps\": {",
+			ecb_rate(decryp));
+		for (i=0; i<NSIZES; i++)
+			printf(" \"%d\": %.4f%s", bufsizes[i],
+				cfb_rate(decryp,bufsizes[i]), i<NSIZES-1 ? "," : "");
+		printf(" } }%s\n", decryp ? "" : ",");
+	}
+	printf("  }%s\n", last ? "" : ",");
+	fflush(stdout);
+}	/* time_control */
+
+
+int main(int argc, char *argv[])
+{	short control = -1;	/* -1 means all 64 settings */
+	long ms = 1000;
+	short i;
+
+	if (argc > 1)
+	{	ms = atol(argv[1]);
+		ms = max(ms,1);
+	}
+	if (argc > 2)
+		control = (short) strtol(argv[2],NULL,0) & 0x3f;
+	minticks = (clock_t) (ms * CLOCKS_PER_SEC / 1000);
+	if (minticks < 1)
+		minticks = 1;
+
+	for (i=1; i<KEYLEN; i++)	/* any fixed key will do */
+		key[i] = (byte) (i*37 + 11);
+	for (i=0; i<MAXBUF; i++)
+		buf[i] = (byte) i;
+
+	printf("{ \"clocks_per_sec\": %ld, \"min_ms\": %ld, \"keylen\": %d,\n",
+		(long) CLOCKS_PER_SEC, ms, KEYLEN);
+	printf("  \"results\": [\n");
+	if (control >= 0)
+		time_control((byte) control,TRUE);
+	else
+		for (i=0; i<0x40; i++)
+			time_control((byte) i,i==0x3f);
+	printf("  ]\n}\n");
+	bass_flushcache();	/* burn the evidence */
+	return(0);
+}	/* main */
+
+/*------------------- End of basstime.c ----------------------------*/
+
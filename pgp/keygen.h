@@ -1,40 +1,67 @@
-/*	keygen.h - C include file for RSA key generation routines
-
-	(c) Copyright 1986 by Philip Zimmermann.  All rights reserved.
-	The author assumes no liability for damages resulting from the use 
-	of this software, even if the damage results from defects in this 
-	software.  No warranty is expressed or implied.  
-
-	NOTE:  This assumes previous inclusion of "rsalib.h"
-*/
-
-extern word16 primetable[]; /* table of small primes, zero-terminated.*/
-
-boolean primetest(unitptr p);
-	/* Returns TRUE iff p is a prime. */
-
-int nextprime(unitptr p);
-	/* Find next higher prime starting at p, returning result in p. */
-
-void randombits(unitptr p,short nbits);
-	/* Make a random unit array p with nbits of precision. */
-
-int randomprime(unitptr p,short nbits);
-	/* Makes a "random" prime p with nbits significant bits of precision. */
-
-void gcd(unitptr result,unitptr a,unitptr n);
-	/* Computes greatest common divisor via Euclid's algorithm. */
-
-void inv(unitptr x,unitptr a,unitptr n);
-	/* Euclid's algorithm extended to compute multiplicative inverse.
-	   Computes x such that a*x mod n = 1, where 0<a<n */
-
-void derivekeys(unitptr n,unitptr e,unitptr d,
-	unitptr p,unitptr q,unitptr u,short ebits);
-	/* Given primes p and q, derive key components n, e, d, and u. */
-
-int keygen(unitptr n,unitptr e,unitptr d,
-	unitptr p,unitptr q,unitptr u,short keybits,short ebits);
-	/* Generate key components p, q, n, e, d, and u. */
-
-
\ No newline at end of file
+/*	keygen.h - C include file for RSA key generation routines
+
+	(c) Copyright 1986 by Philip Zimmermann.  All rights reserved.
+	The author assumes no liability for damages resulting from the use 
+	of this software, even if the damage results from defects in this 
+	software.  No warranty is expressed or implied.  
+
+	NOTE:  This assumes previous inclusion of "rsalib.h"
+*/
+
+extern word16 primetable[]; /* table of small primes, zero-terminated.
+				Built by the first call to primetest or nextprime. */
+
+/* Values for primality_test, which selects the slow primality test: */
+#define FERMAT_TEST 0		/* 4 trials of Fermat's test */
+#define MILLER_RABIN_TEST 1	/* Miller-Rabin, trials chosen by size */
+
+extern short primality_test;	/* slow primality test used by keygen */
+
+typedef struct {	/* tallies of work done by keygen, for benchmarks */
+	long	primes;		/* primes found by nextprime */
+	long	candidates;	/* odd numbers looked at by nextprime */
+	long	suspects;	/* candidates passed through sieve to slow test */
+	long	composites;	/* suspects found not to be prime */
+	long	modexps;	/* full-length modexps done by slow test */
+	long	composite_modexps;	/* modexps spent rejecting composites */
+	long	modsquares;	/* extra modsquares done by Miller-Rabin test */
+	long	search_ticks;	/* clock ticks spent in nextprime */
+	long	slowtest_ticks;	/* clock ticks spent in slow test */
+	long	derive_ticks;	/* clock ticks in derivekeys, mostly gcd and inv */
+	} KEYGENSTATS;
+
+extern KEYGENSTATS keygenstats;	/* running totals, clear to start */
+
+boolean primetest(unitptr p);
+	/* Returns TRUE iff p is a prime. */
+
+int nextprime(unitptr p);
+	/* Find next higher prime starting at p, returning result in p. */
+
+void randombits(unitptr p,short nbits);
+	/* Make a random unit array p with nbits of precision. */
+
+int randomprime(unitptr p,short nbits);
+	/* Makes a "random" prime p with nbits significant bits of precision. */
+
+extern int (*prime_source)(unitptr p,short nbits);
+	/* If not NULL, keygen tries it for each prime before searching. */
+
+short primesizes(short keybits,short *pbits,short *qbits);
+	/* Works out the sizes of the primes keygen will want for a key. */
+
+void gcd(unitptr result,unitptr a,unitptr n);
+	/* Computes greatest common divisor via Euclid's algorithm. */
+
+void inv(unitptr x,unitptr a,unitptr n);
+	/* Euclid's algorithm extended to compute multiplicative inverse.
+	   Computes x such that a*x mod n = 1, where 0<a<n */
+
+void derivekeys(unitptr n,unitptr e,unitptr d,
+	unitptr p,unitptr q,unitptr u,short ebits);
+	/* Given primes p and q, derive key components n, e, d, and u. */
+
+int keygen(unitptr n,unitptr e,unitptr d,
+	unitptr p,unitptr q,unitptr u,short keybits,short ebits);
+	/* Generate key components p, q, n, e, d, and u. */
+
@@ -1,100 +1,156 @@
-/*
-**	lfsr.c - Linear Feedback Shift Register (LFSR) routines.
-**	(c) 1988 Philip Zimmermann.  All rights reserved.
-**	10 Sep 88 -- revised 20 Jun 89
-*/
-
-#include "lfsr.h"	/* Linear Feedback Shift Register headers */
-
-/* Calling routines must declare lfsr buffer and byte index into it.: */
-/* byte lfsr[256] = {0}; */
-/* byte rtail = 0;	/* points to 256, which is same as 0 */
-
-
-/*
-**	steplfsr256 - Step big linear feedback shift register (LFSR)
-**	256 cycles.  Use primitive polynomial:  X^255 + X^82 + X^0
-**	Actually runs 8 LFSR's in parallel, outputting a whole byte
-**	with each step.
-*/
-void steplfsr256(register byteptr lfsr)
-{	register byte ltail;
-	register byte ltap0;
-	register byte ltap82;
-	register byte ltap255;
-	ltail = 0; ltap0 = 0; ltap82 = 82; ltap255 = 255;
-	do
-		lfsr[--ltail] = lfsr[ltap0--]^lfsr[ltap82--]^lfsr[ltap255--];
-	while (ltail);
-} /* steplfsr256 */
-
-
-/*
-**	getlfsr - get 1 byte from lfsr buffer.
-**	Calls steplfsr256() if necessary to replenish lfsr buffer.
-**
-**	getlfsr() is a #define in the header file "lfsr.h"
-*/
-
-
-/*
-**	initlfsr - initialize linear feedback shift register
-**
-**	Since each of the 8 bits of the bytes in the LFSR array represents
-**	a separate independant LFSR, we must be sure the every one of the
-**	8 LFSRs have some 1's and 0's in it.  Therefore, an unmodified
-**	7-bit ASCII string is not an acceptable seed for the LFSR byte
-**	array, because the high bits are all zeros.  That's why we do a
-**	cumulative add on the seed bits, to mix the seed bits up between
-**	the 8 LFSRs.
-*/
-void initlfsr(byteptr seed, short size, byteptr lfsr, byte *rtail)
-/*	seed is random number seed.
-	size is number of bytes in seed.
-	lfsr is pointer to 256-byte LFSR buffer.
-	*rtail is rtail index byte.
-*/
-{	short i;
-	unsigned int c;
-#ifdef CHECKLFSR
-	byte check1,check0;	/* to ensure 1s and 0s mixed in each LFSR */
-	check0 = 0x00;		/* should end up as 0xff after ORing */
-	check1 = 0xff;		/* should end up as 0x00 after ANDing */
-#endif	/* CHECKLFSR */
-	*rtail = 0;		/* points to 256, which is same as 0 */
-	c = size;		/* makes seed "AAA" distinct from seed "AAAAAA" */
-	for (i=0; i<=255; i++)	/* make several seed copies across the LFSR */
-	{	c += seed[i % size];	/* cumulatively add the seed data */
-		lfsr[i] = c + (c>>8);	/* wraparound carry bits */
-#ifdef CHECKLFSR
-		check0 |= lfsr[i];	/* scan for all zeros in any LFSR row */
-		check1 &= lfsr[i];	/* scan for all ones in any LFSR row */
-#endif	/* CHECKLFSR */
-	}
-#ifdef CHECKLFSR
-	/* if any LFSR row contained all zeros, check0 will not be 0xff */
-	/* if any LFSR row contained all ones, check1 will not be 0x00 */
-	c = 0xFF & (check1 | ~check0);	/* should be 0x00 if all went OK. */
-	/* Now guarantee that all 8 LFSRs contain a mix of 1s and 0s... */
-	if (c) printf("\nLFSR check0=%2X check1=%2X. ",check0,check1);
-	lfsr[0] ^= c;		/* flip some faulty bits if we have to */
-#endif	/* CHECKLFSR */
-} /* initlfsr */
-
-
-/*
-**	stomplfsr - inverts about half the bits in an LFSR.
-**
-**	If the LFSR has a "rail" of almost all 0's or almost all 1's in
-**	the same bit position, it will perform poorly as a random number
-**	generator.  This function will probably fix this condition.
-*/
-void stomplfsr(byteptr lfsr)
-/*	lfsr is pointer to 256-byte LFSR buffer. */
-{	byte i;
-	i=255;
-	while (i) *lfsr++ ^= i--;
-} /* stomplfsr */
-
-
-
\ No newline at end of file
+/*
+**	lfsr.c - Linear Feedback Shift Register (LFSR) routines.
+**	(c) 1988 Philip Zimmermann.  All rights reserved.
+**	10 Sep 88 -- revised 20 Jun 89
+*/
+
+#include <string.h>	/* for memcpy */
+#include "lfsr.h"	/* Linear Feedback Shift Register headers */
+
+/* Calling routines must declare lfsr buffer and byte index into it.: */
+/* byte lfsr[256] = {0}; */
+/* byte rtail = 0;	/* points to 256, which is same as 0 */
+
+
+/*
+**	steplfsr256 - Step big linear feedback shift register (LFSR)
+**	256 cycles.  Use primitive polynomial:  X^255 + X^82 + X^0
+**	Actually runs 8 LFSR's in parallel, outputting a whole byte
+**	with each step.
+*/
+#ifdef _MSC_VER	/* 16-bit target, step a byte at a time */
+/*	unsigned long is 32 bits here, so stepping a word at a time would 
+	need long shifts, which MSC does with runtime helper calls. 
+*/
+void steplfsr256(register byteptr lfsr)
+{	register byte ltail;
+	register byte ltap0;
+	register byte ltap82;
+	register byte ltap255;
+	ltail = 0; ltap0 = 0; ltap82 = 82; ltap255 = 255;
+	do
+		lfsr[--ltail] = lfsr[ltap0--]^lfsr[ltap82--]^lfsr[ltap255--];
+	while (ltail);
+} /* steplfsr256 */
+
+#else	/* not _MSC_VER, step a word at a time */
+typedef unsigned long lfsrword;	/* LFSR bytes are stepped a word at a time */
+#define LFSRWORD sizeof(lfsrword)	/* bytes per word */
+
+/*
+**	Stepping downward from lfsr[255], each new byte is the new byte
+**	above it (or the old lfsr[0], for lfsr[255]), xored with itself 
+**	and with the byte 83 places above it, wrapping around.  The bytes
+**	83 places above a word are all final before the word is stepped, 
+**	so a word of them can be xored in at once, and the chain through 
+**	the new bytes above is a running xor that shifts can compute for 
+**	a whole word.  Gives exactly the same bytes as stepping one at a 
+**	time.  Define HIGHFIRST for Motorola byte order, as in rsalib.
+*/
+void steplfsr256(register byteptr lfsr)
+{	lfsrword w, taps, carry;
+	short k, i;
+	byte last;	/* most recent new byte */
+	last = lfsr[0];	/* old lfsr[0] feeds the first step */
+	k = 256;
+	do
+	{	k -= LFSRWORD;
+		if (k+83 < 256 && k+83+LFSRWORD > 256)
+		{	/* taps wrap around the end of the buffer, step bytes */
+			i = k+LFSRWORD;
+			do
+			{	i--;
+				lfsr[i] = last = last ^ lfsr[i] ^ lfsr[(i+83) & 255];
+			} while (i > k);
+			continue;
+		}
+		memcpy(&w,lfsr+k,LFSRWORD);
+		memcpy(&taps,lfsr+((k+83) & 255),LFSRWORD);
+		w ^= taps;
+		/* xor each byte with all the bytes above it in the word... */
+		carry = last;
+		for (i=8; i<8*LFSRWORD; i<<=1)
+		{
+#ifdef HIGHFIRST	/* higher addresses are less significant */
+			w ^= w << i;
+#else	/* higher addresses are more significant */
+			w ^= w >> i;
+#endif
+			carry |= carry << i;	/* last, in every byte */
+		}
+		w ^= carry;	/* ...and with the new byte above the word */
+		memcpy(lfsr+k,&w,LFSRWORD);
+		last = lfsr[k];
+	} while (k);
+} /* steplfsr256 */
+#endif	/* not _MSC_VER */
+
+
+/*
+**	getlfsr - get 1 byte from lfsr buffer.
+**	Calls steplfsr256() if necessary to replenish lfsr buffer.
+**
+**	getlfsr() is a #define in the header file "lfsr.h"
+*/
+
+
+/*
+**	initlfsr - initialize linear feedback shift register
+**
+**	Since each of the 8 bits of the bytes in the LFSR array represents
+**	a separate independant LFSR, we must be sure the every one of the
+**	8 LFSRs have some 1's and 0's in it.  Therefore, an unmodified
+**	7-bit ASCII string is not an acceptable seed for the LFSR byte
+**	array, because the high bits are all zeros.  That's why we do a
+**	cumulative add on the seed bits, to mix the seed bits up between
+**	the 8 LFSRs.
+*/
+void initlfsr(byteptr seed, short size, byteptr lfsr, byte *rtail)
+/*	seed is random number seed.
+	size is number of bytes in seed.
+	lfsr is pointer to 256-byte LFSR buffer.
+	*rtail is rtail index byte.
+*/
+{	short i;
+	unsigned int c;
+#ifdef CHECKLFSR
+	byte check1,check0;	/* to ensure 1s and 0s mixed in each LFSR */
+	check0 = 0x00;		/* should end up as 0xff after ORing */
+	check1 = 0xff;		/* should end up as 0x00 after ANDing */
+#endif	/* CHECKLFSR */
+	*rtail = 0;		/* points to 256, which is same as 0 */
+	c = size;		/* makes seed "AAA" distinct from seed "AAAAAA" */
+	for (i=0; i<=255; i++)	/* make several seed copies across the LFSR */
+	{	c += seed[i % size];	/* cumulatively add the seed data */
+		lfsr[i] = c + (c>>8);	/* wraparound carry bits */
+#ifdef CHECKLFSR
+		check0 |= lfsr[i];	/* scan for all zeros in any LFSR row */
+		check1 &= lfsr[i];	/* scan for all ones in any LFSR row */
+#endif	/* CHECKLFSR */
+	}
+#ifdef CHECKLFSR
+	/* if any LFSR row contained all zeros, check0 will not be 0xff */
+	/* if any LFSR row contained all ones, check1 will not be 0x00 */
+	c = 0xFF & (check1 | ~check0);	/* should be 0x00 if all went OK. */
+	/* Now guarantee that all 8 LFSRs contain a mix of 1s and 0s... */
+	if (c) printf("\nLFSR check0=%2X check1=%2X. ",check0,check1);
+	lfsr[0] ^= c;		/* flip some faulty bits if we have to */
+#endif	/* CHECKLFSR */
+} /* initlfsr */
+
+
+/*
+**	stomplfsr - inverts about half the bits in an LFSR.
+**
+**	If the LFSR has a "rail" of almost all 0's or almost all 1's in
+**	the same bit position, it will perform poorly as a random number
+**	generator.  This function will probably fix this condition.
+*/
+void stomplfsr(byteptr lfsr)
+/*	lfsr is pointer to 256-byte LFSR buffer. */
+{	byte i;
+	i=255;
+	while (i) *lfsr++ ^= i--;
+} /* stomplfsr */
+
+
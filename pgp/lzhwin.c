@@ -0,0 +1,260 @@
+/*--------------------------------------------------------------------------*/
+/*  lzhwin.c - LZSS hash chain encoding and decoding for one ring buffer    */
+/*                                                                          */
+/*  This is not compiled by itself.  lzh.c includes it twice:  once for     */
+/*  the classic 2K window, which is in the data segment, and once, with     */
+/*  the functions renamed, for the large window, which is in far memory     */
+/*  with 16-bit MSC.  That way the classic window is never reached through  */
+/*  a far pointer.  Before each include, lzh.c defines:                     */
+/*                                                                          */
+/*      WIN         the ring buffer                                         */
+/*      WINFAR      FAR if the ring buffer and hash chains are far, or      */
+/*                  nothing                                                 */
+/*      HEAD        newest position in each hash chain                      */
+/*      PREV        next older position in the chain, for each position     */
+/*--------------------------------------------------------------------------*/
+
+/*  SameWord compares the unsigned words at byte addresses a and b.  MSC    */
+/*  loads them through a cast pointer.  Other compilers may assume that a   */
+/*  uchar buffer is never read as unsigned, so they get memcmp, which they  */
+/*  turn into the same single load and compare.                             */
+#ifdef _MSC_VER
+#define SameWord(a,b)   (*(unsigned WINFAR *)(a) == *(unsigned WINFAR *)(b))
+#else
+#define SameWord(a,b)   (memcmp( (a), (b), sizeof(unsigned) ) == 0)
+#endif
+
+#define HASH(p)     (((WIN[p] << 4) ^ (WIN[(p) + 1] << 2) \
+                        ^ WIN[(p) + 2]) & (hashSize - 1))
+
+
+/*--------------------------------------------------------------------------*/
+/*  InitHash                                                                */
+/*      Initialize the hash chains to empty.                                */
+/*--------------------------------------------------------------------------*/
+
+static void InitHash( void )
+    {
+    register int  i;
+
+    for (i = 0 ; i < hashSize ; i++)
+        HEAD[i] = hashNil;
+    }
+
+
+/*--------------------------------------------------------------------------*/
+/*  MatchLength                                                             */
+/*      Returns how many bytes at a and b are the same, up to lookSize.     */
+/*      Compares a whole word at a time until the first difference.         */
+/*--------------------------------------------------------------------------*/
+
+static int MatchLength( register uchar WINFAR *a, register uchar WINFAR *b )
+    {
+    register int  i;
+
+    i = 0;
+#ifndef NOUNALIGNED
+    while ((i < lookSize) && SameWord( a + i, b + i ))
+        i += sizeof(unsigned);
+#endif
+    while ((i < lookSize) && (a[i] == b[i]))
+        i++;
+    return ((i < lookSize) ? i : lookSize);
+    }
+
+
+/*--------------------------------------------------------------------------*/
+/*  InsertHash                                                              */
+/*      Puts position r on its hash chain.  First, unless chain is zero,    */
+/*  tries up to chain positions already on the chain, and returns the       */
+/*  longest match found via the global variables matchPos and matchLen,     */
+/*  the nearest one if there is a tie, just as InsertNode does.             */
+/*--------------------------------------------------------------------------*/
+
+static void InsertHash( int r, int chain, int nice )
+    {
+    register int    p, dist;
+    int             i, lastDist, h;
+    uchar WINFAR    *key;
+
+    key = &WIN[r];
+    h = HASH(r);
+    matchLen = 0;
+    lastDist = 0;
+    for (p = HEAD[h]; chain-- > 0 && p != hashNil; p = PREV[p])
+        {
+        dist = (r - p) & (buffSize - 1);
+        if (dist <= lastDist || dist > maxDist)
+            break;              /* slot reused, or too far back     */
+        lastDist = dist;
+        if (WIN[p + matchLen] != key[matchLen])
+            continue;           /* can't be longer than best so far */
+        if ((i = MatchLength( key, &WIN[p] )) > matchLen)
+            {
+            matchLen = i;
+            matchPos = dist - 1;
+            if (i >= nice)
+                break;
+            }
+        }
+    if (matchLen <= THRESHOLD)
+        matchLen = 0;
+    PREV[r] = HEAD[h];
+    HEAD[h] = r;
+    }
+
+
+/*--------------------------------------------------------------------------*/
+/*  HashEncode                                                              */
+/*      LZSS encoding of inFile, finding matches with the hash chains, as   */
+/*  hard as the given level says.  With lazy matching, a match found at r   */
+/*  is held back until InsertHash has looked at r + 1.  If the match there  */
+/*  is longer, the byte at r goes out alone, and the new match is held      */
+/*  back in turn.                                                           */
+/*--------------------------------------------------------------------------*/
+
+static void HashEncode( int level )
+    {
+    int      i, c, len, r, s, n;
+    int      chain, nice;
+    int      heldLen, heldPos;  /* match held back, found at r - 1  */
+    boolean  lazy, held;
+
+    chain = levels[level].chain;
+    nice  = levels[level].nice;
+    lazy  = levels[level].lazy;
+    if (nice > lookSize)
+        nice = lookSize;
+
+    InitHash();             /*  init the hash chains    */
+    s = 0;
+    r = buffSize - lookSize;
+    for (i = 0; i < r; i++)
+        WIN[i] = ' ';
+
+    /*  fill the look ahead buffer  */
+
+    for (len = 0; (len < lookSize) && ((c = getRLC( inFile )) != EOF); len++)
+        WIN[r + len] = c;
+    for (i = lookSize; i >= 1; i--)
+        InsertHash( r - i, 0, nice );
+    InsertHash( r, chain, nice );
+    held = FALSE;
+    do  {
+        if (matchLen > len)
+            matchLen = len;
+        n = 1;              /*  how far to move ahead   */
+        if (held && (heldLen >= matchLen))
+            {
+            /*  the match held back is at least as long, so send it     */
+            EncodeChar( 255 - THRESHOLD + heldLen );
+            EncodePosition( heldPos );
+            n = heldLen - 1;    /*  it began at r - 1   */
+            held = FALSE;
+            }
+        else
+            {
+            if (held)       /*  the match at r is longer    */
+                EncodeChar( WIN[(r - 1) & (buffSize - 1)] );
+            held = FALSE;
+            if (matchLen <= THRESHOLD)
+                EncodeChar( WIN[r] );
+            else
+            if (lazy && (matchLen < nice))
+                {
+                heldLen = matchLen;
+                heldPos = matchPos;
+                held = TRUE;
+                }
+            else
+                {
+                EncodeChar( 255 - THRESHOLD + matchLen );
+                EncodePosition( matchPos );
+                n = matchLen;
+                }
+            }
+
+        /*  Move ahead n bytes.  Only the last new position needs to be  */
+        /*  matched, the others are just put on their hash chains.      */
+
+        for (i = 1; i <= n; i++)
+            {
+            if ((c = getRLC( inFile )) != EOF)
+                {
+                WIN[s] = c;
+                if (s < lookSize - 1)
+                    WIN[s + buffSize] = c;
+                }
+            else
+                len--;
+            s = (s + 1) & (buffSize - 1);
+            r = (r + 1) & (buffSize - 1);
+            if (len > 0)
+                InsertHash( r, (i == n) ? chain : 0, nice );
+            }
+        }
+    while (len > 0);
+    }
+
+
+/*--------------------------------------------------------------------------*/
+/*  Decode                                                                  */
+/*      Does the work of lzhDecode and lzhDecodeLarge, with whichever       */
+/*  window is set up.                                                       */
+/*--------------------------------------------------------------------------*/
+
+static void Decode( FILE *in, FILE *out )
+    {
+    int  i, j, k, r, c;
+    unsigned long int   textsize;
+	static char *werr = "lzhDecode: can't write output file!";
+
+	inFile  = in;	/* set the global file pointers */
+	outFile = out;
+
+	/* get the size of the input file in the first word */
+
+    if (fread( &textsize, sizeof textsize, 1, inFile ) < 1)
+        Error( "lzhDecode: Can't read the input file" );
+
+	convert( textsize );	/* convert to little endian if necessary */
+    if (textsize == 0)
+        return;             /*  nothing to decode, empty file   */
+
+    StartHuff();
+    for (i = 0; i < (int) (buffSize - lookSize); i++)
+        WIN[i] = ' ';
+    r = buffSize - lookSize;
+
+    outCount = 0;           /*  init the output character count */
+    while (outCount < textsize )
+        {
+        c = DecodeChar();
+        if (c < 256)
+            {
+            if (putRLC( c, outFile ) == EOF)
+                Error( werr );
+
+            WIN[r++] = c;
+            r &= (buffSize - 1);
+            }
+        else
+            {
+            i = (r - DecodePosition() - 1) & (buffSize - 1);
+            j = c - 255 + THRESHOLD;
+            for (k = 0; k < j; k++)
+                {
+                c = WIN[(i + k) & (buffSize - 1)];
+                if (putRLC( c, outFile ) == EOF)
+                    Error( werr );
+                WIN[r++] = c;
+                r &= (buffSize - 1);
+                }
+            }
+        }
+    }
+
+#undef SameWord
+#undef HASH
+
+/* ----	end of lzhwin.c */
@@ -0,0 +1,285 @@
+/*	rsatime.c - Timing driver for RSA library routines
+
+	Measures how much the time taken by rsa_decrypt varies from one
+	message to the next for a given key, so that the normal build of
+	rsalib can be compared against a build with FIXED_WINDOW defined.
+	Build it both ways, ie:  cl /c /Oxaz /Za /DFIXED_WINDOW rsalib.c
+	and compare the reports.  
+	With -p, it instead times the search for random primes with each 
+	of the slow primality tests keygen can use, from the same starting
+	points.
+	With -k, it times keygen itself, and breaks the time down into
+	sieving, slow primality tests and derivekeys.  Without keybits, 
+	it does this for each of the standard key sizes.
+	It uses only the pseudorandom generator, so it needs no keyboard 
+	input and every run sees the same keys, messages and primes.
+
+	Usage:  rsatime [keybits [trials]]
+	        rsatime -p [primebits [trials]]
+	        rsatime -k [keybits [keys]]
+
+	Times are as fine as the C library clock() allows, which is only
+	55 milliseconds on an IBM PC, so use a big enough key to make the
+	samples meaningful.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "rsalib.h"
+#include "keygen.h"
+#include "random.h"
+
+#define MAXTRIALS 1000	/* most trials we can time in one run */
+
+static long times[MAXTRIALS];	/* milliseconds for each trial */
+
+static KEYGENSTATS zerostats;	/* all zeros, for clearing keygenstats */
+
+
+static void pseudobits(unitptr p, short nbits)
+/*	Like randombits, but fills p from the pseudorandom generator, so
+	that runs can be repeated without keyboard input.
+*/
+{	short i;
+	mp_init(p,0);
+	for (i=0; i<nbits; i++)
+		if (pseudorand() & 0x8000)	/* use top bit, low bits of LCG are weak */
+			mp_setbit(p,i);
+}	/* pseudobits */
+
+
+static int pseudoprime(unitptr p, short nbits)
+/*	Like randomprime, but from a pseudorandom starting point. */
+{	pseudobits(p,nbits-2);
+	mp_setbit(p,nbits-1);
+	mp_setbit(p,nbits-2);
+	return(nextprime(p));
+}	/* pseudoprime */
+
+
+static int compare_times(const void *a, const void *b)
+/*	Used by qsort to sort times in ascending order. */
+{	long x = *(long *)a, y = *(long *)b;
+	return(x < y ? -1 : (x > y ? 1 : 0));
+}	/* compare_times */
+
+
+static void show_latency(short trials)
+/*	Reports the distribution of the first trials entries of times. */
+{	short i;
+	double mean, variance;
+
+	mean = 0.0;
+	for (i=0; i<trials; i++)
+		mean += times[i];
+	mean /= trials;
+	variance = 0.0;
+	for (i=0; i<trials; i++)
+		variance += (times[i]-mean) * (times[i]-mean);
+	variance /= trials;
+
+	qsort(times,trials,sizeof(times[0]),compare_times);
+	printf("  p50 = %ld ms,  p99 = %ld ms,  max = %ld ms\n",
+		times[trials/2], times[(trials*99L)/100], times[trials-1]);
+	printf("  mean = %.1f ms,  variance = %.1f ms squared\n",mean,variance);
+}	/* show_latency */
+
+
+static int time_decrypt(short keybits, short trials)
+/*	Reports the spread of times taken by rsa_decrypt on random messages. */
+{	unit n[MAX_UNIT_PRECISION], e[MAX_UNIT_PRECISION];
+	unit d[MAX_UNIT_PRECISION], p[MAX_UNIT_PRECISION];
+	unit q[MAX_UNIT_PRECISION], u[MAX_UNIT_PRECISION];
+	unit M[MAX_UNIT_PRECISION], C[MAX_UNIT_PRECISION];
+	unit check[MAX_UNIT_PRECISION];
+	short i;
+	clock_t start;
+
+	set_precision(bits2units(keybits+SLOP_BITS));
+	printf("Making a %d-bit test key ",keybits);
+	if (pseudoprime(p,keybits/2) < 0 || pseudoprime(q,keybits-keybits/2) < 0)
+	{	printf("\nCan't find primes for test key.\n");
+		return(1);
+	}
+	derivekeys(n,e,d,p,q,u,5);
+	printf("\nTiming %d calls to rsa_decrypt...\n",trials);
+
+	for (i=0; i<trials; i++)
+	{	pseudobits(C,countbits(n)-1);	/* random message < n */
+		start = clock();
+		rsa_decrypt(M,C,d,p,q,u);
+		times[i] = (long) (clock() - start) * 1000L / CLOCKS_PER_SEC;
+		if (i==0)	/* make sure the key and math are good */
+		{	mp_modexp(check,M,e,n);
+			if (mp_compare(check,C) != 0)
+			{	printf("rsa_decrypt gave wrong answer.\n");
+				return(1);
+			}
+		}
+	}
+
+	printf("rsa_decrypt latency, %d-bit key, %d trials:\n",keybits,trials);
+	show_latency(trials);
+
+	mp_burn(d);	/* burn the evidence */
+	mp_burn(u);
+	return(0);
+}	/* time_decrypt */
+
+
+static void time_primes(short bits, short trials)
+/*	Reports the cost of finding random primes with each slow primality 
+	test.  Both tests search from the same pseudorandom starting points.
+*/
+{	unit start[MAX_UNIT_PRECISION], p[MAX_UNIT_PRECISION];
+	static char *testname[2] = { "Fermat", "Miller-Rabin" };
+	KEYGENSTATS tally[2];
+	long ticks[2];
+	short i, test;
+	clock_t t0;
+	double seconds;
+
+	set_precision(bits2units(bits+SLOP_BITS));
+	for (test=0; test<2; test++)
+	{	tally[test] = zerostats;
+		ticks[test] = 0;
+	}
+	printf("Timing search for %d random %d-bit primes...\n",trials,bits);
+	for (i=0; i<trials; i++)
+	{	pseudobits(start,bits-2);
+		mp_setbit(start,bits-1);
+		mp_setbit(start,bits-2);
+		for (test=0; test<2; test++)
+		{	primality_test = test ? MILLER_RABIN_TEST : FERMAT_TEST;
+			keygenstats = tally[test];
+			mp_move(p,start);
+			t0 = clock();
+			if (nextprime(p) < 0)
+				printf("No prime found.\n");
+			ticks[test] += clock() - t0;
+			tally[test] = keygenstats;
+		}
+	}
+	primality_test = FERMAT_TEST;
+
+	for (test=0; test<2; test++)
+	{	seconds = (double) ticks[test] / CLOCKS_PER_SEC;
+		printf("%s test:  %.2f seconds per prime, ",
+			testname[test], seconds/trials);
+		if (seconds > 0.0)
+			printf("%.1f candidates per second\n",
+				tally[test].suspects/seconds);
+		else
+			printf("too fast to time\n");
+		printf("  %.1f suspects per prime, %.2f modexps per composite, ",
+			(double) tally[test].suspects/trials, 
+			tally[test].composites ? (double) tally[test].composite_modexps
+				/ tally[test].composites : 0.0);
+		printf("%.1f modexps per prime",
+			(double) tally[test].modexps/trials);
+		if (tally[test].modsquares)	/* Miller-Rabin squarings */
+			printf(", plus %.1f modsquares",
+				(double) tally[test].modsquares/trials);
+		printf("\n");
+	}
+}	/* time_primes */
+
+
+static int time_keys(short keybits, short keys)
+/*	Reports how long keygen takes to make keys, and where the time 
+	goes.  keygen gets its primes through prime_source from pseudoprime, 
+	so it never asks for keystrokes, but it still finds them with 
+	nextprime, just as it would from truly random starting points.
+*/
+{	unit n[MAX_UNIT_PRECISION], e[MAX_UNIT_PRECISION];
+	unit d[MAX_UNIT_PRECISION], p[MAX_UNIT_PRECISION];
+	unit q[MAX_UNIT_PRECISION], u[MAX_UNIT_PRECISION];
+	short i;
+	clock_t start;
+	long total;
+	double primes;
+
+	printf("Timing keygen for %d %d-bit keys...\n",keys,keybits);
+	prime_source = pseudoprime;
+	keygenstats = zerostats;
+	total = 0;
+	for (i=0; i<keys; i++)
+	{	start = clock();
+		if (keygen(n,e,d,p,q,u,keybits,5) < 0)
+		{	printf("Keygen failed.\n");
+			prime_source = NULL;
+			return(1);
+		}
+		times[i] = (long) (clock() - start) * 1000L / CLOCKS_PER_SEC;
+		total += times[i];
+	}
+	prime_source = NULL;
+
+	printf("keygen latency, %d-bit keys, %d keys:\n",keybits,keys);
+	show_latency(keys);
+	primes = keygenstats.primes ? (double) keygenstats.primes : 1.0;
+	printf("  per prime:  %.1f candidates, %.1f suspects, %.1f modexps\n",
+		keygenstats.candidates/primes, keygenstats.suspects/primes,
+		keygenstats.modexps/primes);
+	printf("  ms per key:  sieve %.0f,  slowtest %.0f,  derivekeys %.0f,  other %.0f\n",
+		(double) (keygenstats.search_ticks - keygenstats.slowtest_ticks)
+			* 1000.0 / CLOCKS_PER_SEC / keys,
+		(double) keygenstats.slowtest_ticks * 1000.0 / CLOCKS_PER_SEC / keys,
+		(double) keygenstats.derive_ticks * 1000.0 / CLOCKS_PER_SEC / keys,
+		((double) total - (double) (keygenstats.search_ticks 
+			+ keygenstats.derive_ticks) * 1000.0 / CLOCKS_PER_SEC) / keys);
+
+	mp_burn(d);	/* burn the evidence */
+	mp_burn(p);
+	mp_burn(q);
+	mp_burn(u);
+	return(0);
+}	/* time_keys */
+
+
+int main(int argc, char *argv[])
+{	short bits = 512, trials = 100;
+	boolean primes = FALSE;	/* TRUE means time prime search */
+	boolean keys = FALSE;	/* TRUE means time keygen */
+	static short keysizes[] = { 286, 510, 990, 0 };	/* standard sizes */
+	short i;
+
+	if (argc > 1 && strcmp(argv[1],"-p") == 0)
+	{	primes = TRUE;
+		bits = 256;
+		trials = 10;
+		argc--; argv++;
+	}
+	else if (argc > 1 && strcmp(argv[1],"-k") == 0)
+	{	keys = TRUE;
+		bits = 0;	/* 0 means all the standard sizes */
+		trials = 5;
+		argc--; argv++;
+	}
+	if (argc > 1)
+		bits = atoi(argv[1]);
+	if (argc > 2)
+		trials = atoi(argv[2]);
+	if (bits || !keys)
+		bits = min(max(bits,64),MAX_BIT_PRECISION-SLOP_BITS-2);
+	trials = min(max(trials,1),MAXTRIALS);
+
+	if (primes)
+	{	time_primes(bits,trials);
+		return(0);
+	}
+	if (keys)
+	{	if (bits)
+			return(time_keys(bits,trials));
+		for (i=0; keysizes[i]; i++)
+			if (time_keys(keysizes[i],trials))
+				return(1);
+		return(0);
+	}
+	return(time_decrypt(bits,trials));
+}	/* main */
+
+/*------------------- End of rsatime.c -----------------------------*/
+